@@ -0,0 +1,636 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : batch.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Headless command line renderer main module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *               Built from this file and all '.cpp' files of 'rt'
+ *               subdirectories (without 'main.cpp' and 'win' modules),
+ *               needs C++17 and threads support.
+ *               Float versus double benchmark: build second binary
+ *               with 'GORT_FLOAT' defined, render reference with
+ *               '-o ref.pfm' by double one and run float one with
+ *               '-compare ref.pfm' (same scene and size).
+ *               Rays, tests and timers counters ('-stats') are
+ *               collected by build with 'GORT_STATS' defined.
+ *               Benchmark: '-bench all -refs dir -update 1' on the
+ *               baseline stores reference images, later '-bench all
+ *               -refs dir' reports speed and fails on changed or
+ *               missing reference images.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "def.h"
+#include "./rt/rt.h"
+#include "./rt/frame/frame.h"
+#include "./rt/render/render.h"
+#include "./rt/models/models.h"
+#include "./rt/scenes/scenes.h"
+#include "./rt/scenes/scene_file.h"
+
+/* Project namespace */
+namespace gort
+{
+  /* Batch renderer options class */
+  class batch_options
+  {
+  public:
+    std::string Scene = "default";  // Built-in scene name or scene file (.gsc or .gsb)
+    std::string Model;              // Model file (.obj or .g3dm) to be rendered instead of scene
+    std::string Output = "out.tga"; // Output file (.tga, .ppm or .pfm)
+    std::string Hdr;                // Additional float output (.pfm)
+    std::string Tonemap;            // Float input to be re-tonemapped instead of rendering
+    std::string Convert;            // Text scene to be converted to binary instead of rendering
+    std::string Compare;            // Reference float image to compare result with
+    std::string Stats;              // Statistics output (.json or .csv)
+    std::string Bench;              // Benchmark cases ("all" or comma separated names) instead of rendering
+    std::string Refs;               // Benchmark reference images directory
+    BOOL Update = FALSE;            // Store benchmark images as references
+    INT Repeat = 3;                 // Benchmark frames per run (best time is taken)
+    DBL MinPsnr = 50;               // Benchmark reference match limit in dB
+    INT W = 640, H = 480;           // Frame size
+    INT Samples = 1;                // Samples per pixel
+    INT Threads = 0;                // Rendering threads (0 for all cores)
+    INT Budget = 32;                // Traced rays limit per camera ray
+    INT Passes = 0;                 // Progressive passes (0 for single frame render)
+    DBL Adaptive = 0;               // Adaptive sampling target error (0 for uniform sampling)
+    DBL TimeBudget = 0;             // Adaptive sampling frame time limit (0 for none)
+    BOOL Packets = TRUE;            // Packet tracing of camera rays
+    BOOL Wavefront = FALSE;         // Wavefront tracing of tiles
+    BOOL Jitter = FALSE;            // Jittered samples inside strata
+    BOOL Packed = FALSE;            // Per type arrays storage of simple shapes
+    bvh::mode BuildMode = bvh::BINNED; // Hierarchy build mode
+    DBL LightCutoff = 1.0 / 1024;   // Light contribution cutoff (0 to keep all lights)
+    DBL Exposure = 1;               // Tonemap exposure
+
+    /* Parse command line function.
+     * ARGUMENTS:
+     *   - command line arguments:
+     *       INT Argc; CHAR *Argv[];
+     * RETURNS:
+     *   (BOOL) TRUE if command line is correct.
+     */
+    BOOL Parse( INT Argc, CHAR *Argv[] )
+    {
+      for (INT i = 1; i < Argc; i++)
+      {
+        std::string Opt = Argv[i];
+
+        if (i + 1 >= Argc)
+          return FALSE;
+        if (Opt == "-scene")
+          Scene = Argv[++i];
+        else if (Opt == "-model")
+          Model = Argv[++i];
+        else if (Opt == "-o")
+          Output = Argv[++i];
+        else if (Opt == "-hdr")
+          Hdr = Argv[++i];
+        else if (Opt == "-compare")
+          Compare = Argv[++i];
+        else if (Opt == "-stats")
+          Stats = Argv[++i];
+        else if (Opt == "-bench")
+          Bench = Argv[++i];
+        else if (Opt == "-refs")
+          Refs = Argv[++i];
+        else if (Opt == "-update")
+          Update = atoi(Argv[++i]) != 0;
+        else if (Opt == "-repeat")
+          Repeat = atoi(Argv[++i]);
+        else if (Opt == "-minpsnr")
+          MinPsnr = atof(Argv[++i]);
+        else if (Opt == "-tonemap")
+          Tonemap = Argv[++i];
+        else if (Opt == "-convert")
+          Convert = Argv[++i];
+        else if (Opt == "-w")
+          W = atoi(Argv[++i]);
+        else if (Opt == "-h")
+          H = atoi(Argv[++i]);
+        else if (Opt == "-spp")
+          Samples = atoi(Argv[++i]);
+        else if (Opt == "-threads")
+          Threads = atoi(Argv[++i]);
+        else if (Opt == "-adaptive")
+          Adaptive = atof(Argv[++i]);
+        else if (Opt == "-time")
+          TimeBudget = atof(Argv[++i]);
+        else if (Opt == "-passes")
+          Passes = atoi(Argv[++i]);
+        else if (Opt == "-budget")
+          Budget = atoi(Argv[++i]);
+        else if (Opt == "-wavefront")
+          Wavefront = atoi(Argv[++i]) != 0;
+        else if (Opt == "-jitter")
+          Jitter = atoi(Argv[++i]) != 0;
+        else if (Opt == "-packed")
+          Packed = atoi(Argv[++i]) != 0;
+        else if (Opt == "-bvh")
+        {
+          std::string Mode = Argv[++i];
+
+          if (Mode == "sweep")
+            BuildMode = bvh::SWEEP;
+          else if (Mode == "binned")
+            BuildMode = bvh::BINNED;
+          else if (Mode == "lbvh")
+            BuildMode = bvh::LBVH;
+          else
+            return FALSE;
+        }
+        else if (Opt == "-lightcut")
+          LightCutoff = atof(Argv[++i]);
+        else if (Opt == "-packets")
+          Packets = atoi(Argv[++i]) != 0;
+        else if (Opt == "-exposure")
+          Exposure = atof(Argv[++i]);
+        else
+          return FALSE;
+      }
+      return W > 0 && H > 0 && Samples > 0 && Threads >= 0 && Passes >= 0 && Budget > 0 && Budget <= MaxRayBudget &&
+        Repeat > 0;
+    } /* End of 'Parse' function */
+  }; /* End of 'batch_options' class */
+
+  /* Save frame by file extension function.
+   * ARGUMENTS:
+   *   - frame to be saved:
+   *       const frame &Frame;
+   *   - file name:
+   *       const std::string &FileName;
+   * RETURNS:
+   *   (BOOL) TRUE if image saved.
+   */
+  static BOOL SaveFrame( const frame &Frame, const std::string &FileName )
+  {
+    std::string Ext = FileName.size() > 4 ? FileName.substr(FileName.size() - 4) : "";
+
+    if (Ext == ".pfm")
+      return Frame.SavePFM(FileName);
+    if (Ext == ".ppm")
+      return Frame.SavePPM(FileName);
+    return Frame.SaveTGA(FileName);
+  } /* End of 'SaveFrame' function */
+
+  /* Compare frame with reference image function.
+   * ARGUMENTS:
+   *   - rendered frame:
+   *       const frame &Frame;
+   *   - reference image (of the same size):
+   *       const frame &Ref;
+   *   - root mean square and maximal channel errors pointers:
+   *       DBL *Rmse, *MaxErr;
+   * RETURNS:
+   *   (DBL) peak signal to noise ratio in dB for colors clamped to [0, 1].
+   */
+  static DBL CompareFrames( const frame &Frame, const frame &Ref, DBL *Rmse, DBL *MaxErr )
+  {
+    DBL Sum = 0;
+
+    *MaxErr = 0;
+    for (INT y = 0; y < Frame.GetH(); y++)
+      for (INT x = 0; x < Frame.GetW(); x++)
+      {
+        vec3 A = Frame.GetPixel(x, y), B = Ref.GetPixel(x, y);
+
+        for (INT i = 0; i < 3; i++)
+        {
+          DBL
+            a = mth::Clamp<DBL>(A[i], 0, 1),
+            b = mth::Clamp<DBL>(B[i], 0, 1),
+            d = fabs(a - b);
+
+          Sum += d * d;
+          if (d > *MaxErr)
+            *MaxErr = d;
+        }
+      }
+    *Rmse = sqrt(Sum / (3.0 * Frame.GetW() * Frame.GetH()));
+    return *Rmse > 0 ? -20 * log10(*Rmse) : HUGE_VAL;
+  } /* End of 'CompareFrames' function */
+
+  /* Obtain seconds since moment function.
+   * ARGUMENTS:
+   *   - start moment:
+   *       std::chrono::high_resolution_clock::time_point Start;
+   * RETURNS:
+   *   (DBL) elapsed seconds.
+   */
+  static DBL Elapsed( std::chrono::high_resolution_clock::time_point Start )
+  {
+    return std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count();
+  } /* End of 'Elapsed' function */
+
+  /* Benchmark case class */
+  class bench_case
+  {
+  public:
+    const CHAR *Name;   // Case name
+    const CHAR *Scene;  // Built-in scene name
+    INT Budget;         // Traced rays limit per camera ray
+  }; /* End of 'bench_case' class */
+
+  /* Benchmark cases */
+  static const bench_case BenchCases[] =
+  {
+    {"window",     "default",    32},  // window application scene
+    {"spheres",    "spheres",    32},  // many spheres grid
+    {"manylights", "manylights", 32},  // many lights
+    {"mesh",       "mesh",       32},  // high poly mesh
+    {"glass",      "glass",      64},  // deep refraction paths
+    {"area",       "area",       32},  // soft shadows of area lights
+    {"textured",   "textured",   32},  // mip mapped textures
+  };
+
+  /* Benchmark frame sizes */
+  static const INT BenchSizes[][2] = {{320, 240}, {640, 480}};
+
+  /* Evaluate frame checksum function.
+   * ARGUMENTS:
+   *   - frame:
+   *       const frame &Frame;
+   * RETURNS:
+   *   (UINT64) FNV-1a hash of 8 bit clamped colors.
+   */
+  static UINT64 FrameChecksum( const frame &Frame )
+  {
+    UINT64 Hash = 0xCBF29CE484222325;
+
+    for (INT y = 0; y < Frame.GetH(); y++)
+      for (INT x = 0; x < Frame.GetW(); x++)
+      {
+        vec3 C = Frame.GetPixel(x, y);
+
+        for (INT i = 0; i < 3; i++)
+          Hash = (Hash ^ static_cast<BYTE>(mth::Clamp<DBL>(C[i], 0, 1) * 255 + 0.5)) * 0x100000001B3;
+      }
+    return Hash;
+  } /* End of 'FrameChecksum' function */
+
+  /* Run benchmark function.
+   * Every case is rendered at every benchmark size by 1, 2, 4, ...
+   * threads up to the maximum. Single thread image is compared with
+   * stored reference, other thread counts must give the same image.
+   * ARGUMENTS:
+   *   - options:
+   *       const batch_options &Opt;
+   * RETURNS:
+   *   (INT) Error level for operation system (0 if all images match).
+   */
+  static INT RunBenchmark( const batch_options &Opt )
+  {
+    INT MaxThreads = Opt.Threads > 0 ? Opt.Threads : max(static_cast<INT>(std::thread::hardware_concurrency()), 1);
+    std::vector<INT> Threads;
+    INT Runs = 0, Failed = 0;
+
+    for (INT t = 1; t < MaxThreads; t *= 2)
+      Threads.push_back(t);
+    Threads.push_back(MaxThreads);
+
+    std::string Ext = Opt.Output.size() > 4 ? Opt.Output.substr(Opt.Output.size() - 4) : "";
+    FILE *Csv = Ext == ".csv" ? fopen(Opt.Output.c_str(), "w") : nullptr;
+
+    if (Csv != nullptr)
+      fprintf(Csv, "case,width,height,threads,frame_s,mrays_s,scaling,psnr_db,checksum,status\n");
+    printf("%-10s %9s %7s %9s %9s %7s %8s %16s  %s\n", "case", "size", "threads", "frame, s", "Mrays/s", "scaling",
+      "psnr, dB", "checksum", "status");
+    for (auto &Case : BenchCases)
+    {
+      if (Opt.Bench != "all" && ("," + Opt.Bench + ",").find(std::string(",") + Case.Name + ",") == std::string::npos)
+        continue;
+
+      scene Scene;
+      camera Cam;
+
+      if (!LoadScene(Scene, Cam, Case.Scene))
+      {
+        printf("%-10s cannot load scene '%s'\n", Case.Name, Case.Scene);
+        Failed++;
+        continue;
+      }
+      Scene.SetRayBudget(Case.Budget);
+      Scene.SetPacked(Opt.Packed);
+      Scene.SetBuildMode(Opt.BuildMode);
+      Scene.SetLightCutoff(Opt.LightCutoff);
+      for (auto &Size : BenchSizes)
+      {
+        frame Frame;
+        DBL Time1 = 0, Psnr = HUGE_VAL;
+        UINT64 Sum1 = 0;
+
+        Frame.Resize(Size[0], Size[1]);
+        Cam.Resize(Size[0], Size[1]);
+        for (INT t : Threads)
+        {
+          renderer Renderer(t);
+          DBL Best = HUGE_VAL, RaysPerSec = 0;
+
+          Renderer.SetSamples(Opt.Samples);
+          Renderer.SetPackets(Opt.Packets);
+          Renderer.SetWavefront(Opt.Wavefront);
+          Renderer.SetJitter(Opt.Jitter);
+          if (!Scene.IsBuilt())
+            Renderer.Build(Scene);
+          for (INT r = 0; r < Opt.Repeat; r++)
+          {
+            Renderer.Render(Scene, Cam, Frame);
+            if (Renderer.GetFrameTime() < Best)
+              Best = Renderer.GetFrameTime(), RaysPerSec = Renderer.GetRaysPerSec();
+          }
+
+          UINT64 Sum = FrameChecksum(Frame);
+          const CHAR *Status = "ok";
+          BOOL IsFailed = FALSE;
+
+          if (t == 1)
+          {
+            // single thread image against reference
+            std::string Ref = Opt.Refs + "/" + Case.Name + "_" + std::to_string(Size[0]) + "x" + std::to_string(Size[1]) + ".pfm";
+            frame RefFrame;
+            DBL Rmse, MaxErr;
+
+            Time1 = Best;
+            Sum1 = Sum;
+            if (Opt.Refs.empty())
+              Status = "no refs";
+            else if (Opt.Update)
+            {
+              if (Frame.SavePFM(Ref))
+                Status = "stored";
+              else
+                Status = "cannot store", IsFailed = TRUE;
+            }
+            else if (!RefFrame.LoadPFM(Ref) || RefFrame.GetW() != Frame.GetW() || RefFrame.GetH() != Frame.GetH())
+              Status = "MISSING", IsFailed = TRUE;
+            else if ((Psnr = CompareFrames(Frame, RefFrame, &Rmse, &MaxErr)) < Opt.MinPsnr)
+              Status = "CHANGED", IsFailed = TRUE;
+          }
+          else if (Sum != Sum1)
+            Status = "THREADS DIFFER", IsFailed = TRUE;
+          if (IsFailed)
+            Failed++;
+          Runs++;
+
+          DBL Scaling = Time1 / (Best * t);
+
+          printf("%-10s %4dx%-4d %7d %9.4f %9.3f %6.1f%% %8.2f %016llx  %s\n", Case.Name, Size[0], Size[1], t, Best,
+            RaysPerSec / 1e6, Scaling * 100, Psnr, static_cast<unsigned long long>(Sum), Status);
+          if (Csv != nullptr)
+            fprintf(Csv, "%s,%d,%d,%d,%.6f,%.4f,%.4f,%.2f,%016llx,%s\n", Case.Name, Size[0], Size[1], t, Best,
+              RaysPerSec / 1e6, Scaling, Psnr, static_cast<unsigned long long>(Sum), Status);
+        }
+      }
+    }
+    if (Csv != nullptr)
+      fclose(Csv);
+    printf("bench:   %d runs, %d failed\n", Runs, Failed);
+    return Runs == 0 || Failed > 0;
+  } /* End of 'RunBenchmark' function */
+} /* end of 'gort' namespace */
+
+/* The main program function.
+ * ARGUMENTS:
+ *   - command line arguments:
+ *       INT Argc; CHAR *Argv[];
+ * RETURNS:
+ *   (INT) Error level for operation system (0 for success).
+ */
+INT main( INT Argc, CHAR *Argv[] )
+{
+  using clock = std::chrono::high_resolution_clock;
+  gort::batch_options Opt;
+
+  if (!Opt.Parse(Argc, Argv))
+  {
+    fprintf(stderr,
+      "usage: %s [-scene default|spheres|lights|manylights|spots|mesh|forest|shapes|glass|area|textured|file.gsc|file.gsb | -model file.obj|file.g3dm] [-w W] [-h H] [-spp N] [-threads N] [-budget N]\n"
+      "          [-packets 0|1] [-wavefront 0|1] [-jitter 0|1] [-packed 0|1] [-bvh sweep|binned|lbvh] [-lightcut C] [-passes N] [-adaptive error [-time seconds]]\n"
+      "          [-o out.tga|out.ppm|out.pfm] [-hdr out.pfm] [-compare ref.pfm] [-stats out.json|out.csv]\n"
+      "       %s -tonemap in.pfm [-exposure E] [-o out.tga|out.ppm]\n"
+      "       %s -convert in.gsc -o out.gsb\n"
+      "       %s -bench all|window,spheres,manylights,mesh,glass,area,textured [-refs dir [-update 1] [-minpsnr dB]] [-repeat N]\n"
+      "          [-threads MAX] [-spp N] [-packets 0|1] [-wavefront 0|1] [-jitter 0|1] [-packed 0|1] [-bvh mode] [-o results.csv]\n",
+      Argv[0], Argv[0], Argv[0], Argv[0]);
+    return 1;
+  }
+
+  if (!Opt.Bench.empty())
+    return gort::RunBenchmark(Opt);
+
+  auto Start = clock::now();
+  gort::frame Frame;
+
+  // Tonemap stored float image without tracing
+  if (!Opt.Tonemap.empty())
+  {
+    if (!Frame.LoadPFM(Opt.Tonemap))
+    {
+      fprintf(stderr, "Cannot load '%s'\n", Opt.Tonemap.c_str());
+      return 1;
+    }
+    for (INT y = 0; y < Frame.GetH(); y++)
+      for (INT x = 0; x < Frame.GetW(); x++)
+        Frame.PutPixel(x, y, Frame.GetPixel(x, y) * Opt.Exposure);
+    if (!gort::SaveFrame(Frame, Opt.Output))
+    {
+      fprintf(stderr, "Cannot save '%s'\n", Opt.Output.c_str());
+      return 1;
+    }
+    printf("tonemap: %.3f s\n", gort::Elapsed(Start));
+    return 0;
+  }
+
+  // Convert text scene to binary without tracing
+  if (!Opt.Convert.empty())
+  {
+    std::string Error;
+
+    if (!gort::ConvertSceneFile(Opt.Convert, Opt.Output, &Error))
+    {
+      fprintf(stderr, "%s\n", Error.c_str());
+      return 1;
+    }
+    printf("convert: %.3f s\n", gort::Elapsed(Start));
+    return 0;
+  }
+
+  gort::scene Scene;
+  gort::camera Cam;
+  gort::renderer Renderer(Opt.Threads);
+
+  // Scene setup
+  auto Phase = clock::now();
+  if (!Opt.Model.empty())
+  {
+    gort::aabb BB;
+
+    if (!gort::LoadModel(Scene, Opt.Model, &BB))
+    {
+      fprintf(stderr, "Cannot load model '%s'\n", Opt.Model.c_str());
+      return 1;
+    }
+
+    // Look at model from above front right corner
+    gort::vec3 Size = BB.Max - BB.Min, Center = BB.Center();
+    gort::REAL Diag = !Size;
+
+    Scene << new gort::point(Center + gort::vec3(0.5, 1, 0.7) * Diag, gort::vec3(1), 1, 3 * Diag, 1, 0, 0);
+    Cam.SetLocAtUp(Center + gort::vec3(0.6, 0.5, 0.9) * Diag, Center);
+    Opt.Scene = Opt.Model;
+  }
+  else if (Opt.Scene.find('.') != std::string::npos)
+  {
+    std::string Error;
+
+    if (!gort::LoadSceneFile(Scene, Cam, Opt.Scene, &Error))
+    {
+      fprintf(stderr, "%s\n", Error.c_str());
+      return 1;
+    }
+  }
+  else if (!gort::LoadScene(Scene, Cam, Opt.Scene))
+  {
+    fprintf(stderr, "Unknown scene '%s'\n", Opt.Scene.c_str());
+    return 1;
+  }
+  Frame.Resize(Opt.W, Opt.H);
+  Cam.Resize(Opt.W, Opt.H);
+  DBL SceneTime = gort::Elapsed(Phase);
+
+  // Acceleration structure
+  Phase = clock::now();
+  Scene.SetPacked(Opt.Packed);
+  Scene.SetBuildMode(Opt.BuildMode);
+  Scene.SetLightCutoff(Opt.LightCutoff);
+  Renderer.Build(Scene);
+  DBL BuildTime = gort::Elapsed(Phase);
+
+  // Rendering
+  Renderer.SetSamples(Opt.Samples);
+  Renderer.SetPackets(Opt.Packets);
+  Renderer.SetWavefront(Opt.Wavefront);
+  Renderer.SetJitter(Opt.Jitter);
+  Renderer.SetAdaptive(Opt.Adaptive > 0, Opt.Adaptive, Opt.TimeBudget);
+  Scene.SetRayBudget(Opt.Budget);
+
+  // Progressive passes are rendered as interactive viewer does, but without stop
+  DBL PreviewTime = 0, PassesTime = 0;
+  gort::stats Stats;
+
+  if (Opt.Passes > 0)
+  {
+    Renderer.SetMaxPasses(Opt.Passes);
+    Phase = clock::now();
+    Renderer.RenderProgressive(Scene, Cam, Frame);
+    Stats += Renderer.GetStats();
+    PreviewTime = gort::Elapsed(Phase);
+    Phase = clock::now();
+    while (!Renderer.IsConverged(Scene, Cam, Frame))
+    {
+      Renderer.RenderProgressive(Scene, Cam, Frame);
+      Stats += Renderer.GetStats();
+    }
+    PassesTime = gort::Elapsed(Phase);
+  }
+  else
+  {
+    Renderer.Render(Scene, Cam, Frame);
+    Stats += Renderer.GetStats();
+  }
+
+  // Output
+  Phase = clock::now();
+  if (!gort::SaveFrame(Frame, Opt.Output) || (!Opt.Hdr.empty() && !Frame.SavePFM(Opt.Hdr)))
+  {
+    fprintf(stderr, "Cannot save output image\n");
+    return 1;
+  }
+  DBL OutputTime = gort::Elapsed(Phase);
+
+  printf("scene:   %s, %dx%d, %d spp, %d threads, %s precision\n", Opt.Scene.c_str(), Opt.W, Opt.H, Opt.Samples,
+    Renderer.GetThreads(), sizeof(gort::REAL) == sizeof(FLT) ? "float" : "double");
+  printf("setup:   %.3f s\n", SceneTime);
+  printf("build:   %.3f s (%d nodes, %d packed shapes, %d lights in %d nodes)\n", BuildTime, Scene.GetAccel().GetNodeCount(),
+    Scene.GetPackedCount(), Scene.GetLightTree().GetCount(), Scene.GetLightTree().GetNodeCount());
+  for (const gort::bvh *Tree : {&Scene.GetAccel(), &Scene.GetPackedAccel()})
+    if (Tree->GetPrimCount() > 0)
+      printf("bvh:     %s, %d prims, %.3f s (%.2f Mprims/s), %d leaves, SAH cost %.2f\n",
+        Tree->GetMode() == gort::bvh::SWEEP ? "sweep" : Tree->GetMode() == gort::bvh::BINNED ? "binned" : "lbvh",
+        Tree->GetPrimCount(), Tree->GetBuildTime(), Tree->GetPrimCount() / max(Tree->GetBuildTime(), 1e-9) / 1e6,
+        Tree->GetLeafCount(), Tree->GetCost());
+  printf("render:  %.3f s (%d tiles, %.1f tiles/s)\n", Renderer.GetFrameTime(), Renderer.GetTileCount(), Renderer.GetTilesPerSec());
+  if (Opt.Passes > 0)
+    printf("passes:  preview %.3f s, %d passes %.3f s (%.3f s per pass)\n", PreviewTime, Renderer.GetPassCount(), PassesTime,
+      PassesTime / Renderer.GetPassCount());
+  printf("output:  %.3f s\n", OutputTime);
+  printf("samples: %llu (%.2f per pixel)\n", static_cast<unsigned long long>(Renderer.GetSampleCount()),
+    static_cast<DBL>(Renderer.GetSampleCount()) / (Opt.W * Opt.H));
+  printf("rays:    %llu (%.3f Mrays/s)\n", static_cast<unsigned long long>(Renderer.GetRayCount()), Renderer.GetRaysPerSec() / 1e6);
+  if (Renderer.IsWavefrontUsed())
+  {
+    const gort::stage_times &St = Renderer.GetStageTimes();
+
+    printf("stages:  generate %.3f s, intersect %.3f s, sort %.3f s, shade %.3f s, shadow %.3f s\n",
+      St.Generate, St.Intersect, St.Sort, St.Shade, St.Shadow);
+  }
+  if (gort::stats::IsEnabled())
+  {
+    const UINT64 *C = Stats.Counters;
+    UINT64 Rays = C[gort::stats::CAMERA_RAYS] + C[gort::stats::SECONDARY_RAYS] + C[gort::stats::SHADOW_RAYS];
+
+    printf("counts:  %llu camera, %llu secondary, %llu shadow rays (%.1f%% blocked), %.1f nodes per ray\n",
+      static_cast<unsigned long long>(C[gort::stats::CAMERA_RAYS]),
+      static_cast<unsigned long long>(C[gort::stats::SECONDARY_RAYS]),
+      static_cast<unsigned long long>(C[gort::stats::SHADOW_RAYS]),
+      100.0 * C[gort::stats::SHADOW_BLOCKED] / max(C[gort::stats::SHADOW_RAYS], static_cast<UINT64>(1)),
+      static_cast<DBL>(C[gort::stats::NODE_VISITS]) / max(Rays, static_cast<UINT64>(1)));
+  }
+  if (!Opt.Stats.empty())
+  {
+    CHAR Label[300];
+
+    snprintf(Label, sizeof(Label), "%s %dx%d spp=%d threads=%d packed=%d wavefront=%d jitter=%d bvh=%d lightcut=%g",
+      Opt.Scene.c_str(), Opt.W, Opt.H, Opt.Samples, Renderer.GetThreads(), Opt.Packed, Opt.Wavefront, Opt.Jitter,
+      static_cast<INT>(Opt.BuildMode), Opt.LightCutoff);
+    if (!Stats.Save(Opt.Stats, Label))
+    {
+      fprintf(stderr, "Cannot save statistics '%s'\n", Opt.Stats.c_str());
+      return 1;
+    }
+  }
+  printf("wall:    %.3f s\n", gort::Elapsed(Start));
+
+  // Difference with reference image
+  if (!Opt.Compare.empty())
+  {
+    gort::frame Ref;
+    DBL Rmse, MaxErr;
+
+    if (!Ref.LoadPFM(Opt.Compare) || Ref.GetW() != Frame.GetW() || Ref.GetH() != Frame.GetH())
+    {
+      fprintf(stderr, "Cannot compare with '%s'\n", Opt.Compare.c_str());
+      return 1;
+    }
+    DBL Psnr = gort::CompareFrames(Frame, Ref, &Rmse, &MaxErr);
+    printf("compare: rmse %.6f, max %.6f, psnr %.2f dB\n", Rmse, MaxErr, Psnr);
+  }
+  return 0;
+} /* End of 'main' function */
+
+/* END OF 'batch.cpp' FILE */
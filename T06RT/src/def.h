@@ -20,7 +20,7 @@
 #include "mth/mth.h"
 
 /* Debug memory allocation support */ 
-#ifndef NDEBUG 
+#if defined(_MSC_VER) && !defined(NDEBUG)
 # define _CRTDBG_MAP_ALLOC
 # include <crtdbg.h>
 # define SetDbgMemHooks() \
@@ -38,7 +38,7 @@ public:
 } __ooppss;
 #endif /* _DEBUG */ 
 
-#ifdef _DEBUG 
+#if defined(_MSC_VER) && defined(_DEBUG)
 # ifdef _CRTDBG_MAP_ALLOC 
 #   define new new(_NORMAL_BLOCK, __FILE__, __LINE__) 
 # endif /* _CRTDBG_MAP_ALLOC */ 
@@ -47,13 +47,25 @@ public:
 /* Project namespace */
 namespace gort
 {
+  /* Ray tracing scalar type (single precision build with 'GORT_FLOAT' defined) */
+#ifdef GORT_FLOAT
+  typedef FLT REAL;
+#else /* GORT_FLOAT */
+  typedef DBL REAL;
+#endif /* GORT_FLOAT */
+
+  /* Hit distance tolerance, relative to scene coordinates magnitude
+   * (float keeps about 7 decimal digits, double about 16) */
+  const REAL Threshold = sizeof(REAL) == sizeof(FLT) ? 1e-4 : 1e-9;
+
   /* Math types defenitions */
-  typedef mth::vec2<DBL> vec2;
-  typedef mth::vec3<DBL> vec3;
-  typedef mth::vec4<DBL> vec4;
-  typedef mth::matr<DBL> matr;
-  typedef mth::camera<DBL> camera;
-  typedef mth::ray<DBL> ray;
+  typedef mth::vec2<REAL> vec2;
+  typedef mth::vec3<REAL> vec3;
+  typedef mth::vec4<REAL> vec4;
+  typedef mth::matr<REAL> matr;
+  typedef mth::camera<REAL> camera;
+  typedef mth::ray<REAL> ray;
+  typedef mth::rnd rnd;
 } /* end of 'gort' namespace */
 
 #endif /* __def_h_ */
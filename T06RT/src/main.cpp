@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Main module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 01.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -18,10 +18,14 @@
 #include "./win/win.h"
 #include "./rt/frame/frame.h"
 #include "./rt/rt.h"
+#include "./rt/render/render.h"
 #include "timer.h"
 
+#include <condition_variable>
 #include <cstdlib>
 #include <ctime>
+#include <mutex>
+#include <string>
 #include <thread>
 
 /* Project namespace */
@@ -33,42 +37,69 @@ namespace gort
     camera Cam;  // Camera
     frame Frame; // Frame buffer
 
-    // Threads for prallel rendering
-    std::thread Threads[8];  // Treads for drawing array
-    const int ThCount;       // Treads for drawing count
+    renderer Renderer; // Tile renderer with threads pool
+
+    std::mutex CamLock;                  // Camera lock (changed by window, read by rendering thread)
+    std::condition_variable CamChanged;  // Camera change notification
 
   public:
     scene Scene; // Scene of shapes
 
-    /* Default constructor */
-    raytracer( VOID ) : ThCount(std::thread::hardware_concurrency() - 11)
+    /* Ray tracer class constructor.
+     * ARGUMENTS:
+     *   - rendering threads count (0 for hardware concurrency):
+     *      INT ThreadCount;
+     */
+    raytracer( INT ThreadCount = 0 ) : Renderer(ThreadCount)
     {
     } /* End of 'raytracer' function */
 
-    /* Render frame function.
+    /* Render next progressive pass function.
+     * Sleeps while image is complete for current camera and scene.
      * ARGUMENTS: None.
      * RETURNS: None.
      */
     VOID Render( VOID )
     {
-      // Starting drawing threads
-      for (INT i = 1; i <= ThCount; i++)
-        Threads[i - 1] = std::thread([this, i]()
-          {
-            for (INT y = i; y < Frame.GetH(); y += i)
-              for (INT x = 0; x < Frame.GetW(); x++)
-              {
-                vec3 color = Scene.Trace(Cam.FrameRay(x, y), Scene.Air, 1, 0);
-                Frame.PutPixel(x, y, mth::toRGB(color));
-                InvalidateRect(hWnd, nullptr, TRUE);
-              }
-          });
-
-      // Waiting for all threads
-      for (INT i = 1; i <= ThCount; i++)
-        Threads[i - 1].join();
+      camera View;
+
+      {
+        std::unique_lock<std::mutex> Lk(CamLock);
+
+        CamChanged.wait(Lk, [&]{ return !Renderer.IsConverged(Scene, Cam, Frame); });
+        View = Cam;
+      }
+      if (!Renderer.RenderProgressive(Scene, View, Frame))
+        return;
+      InvalidateRect(hWnd, nullptr, FALSE);
+
+      SetWindowText(hWnd, ("T06RT (Ray Tracing) " +
+        std::to_string(Renderer.GetThreads()) + " threads, pass " +
+        std::to_string(Renderer.GetPassCount()) + ", " +
+        std::to_string(Renderer.GetFrameTime() * 1000) + " ms, " +
+        std::to_string(Renderer.GetTilesPerSec()) + " tiles/s, BVH: " +
+        std::to_string(Scene.GetAccel().GetNodeCount()) + " nodes, " +
+        std::to_string(Scene.GetAccel().GetBuildTime() * 1000) + " ms").c_str());
     } /* End of 'Render' function */
 
+    /* Move camera function.
+     * Current pass is cancelled, so preview of new view is started at once.
+     * ARGUMENTS:
+     *   - movement direction:
+     *      const vec3 &Dir;
+     * RETURNS: None.
+     */
+    VOID MoveCamera( const vec3 &Dir )
+    {
+      {
+        std::lock_guard<std::mutex> Lk(CamLock);
+
+        Cam.Move(Dir);
+      }
+      Renderer.Cancel();
+      CamChanged.notify_one();
+    } /* End of 'MoveCamera' function */
+
     /* Rendering thread handle function.
      * ARGUMENTS:
      *   - thread input pointer:
@@ -209,6 +240,9 @@ namespace gort
       //Render();
       //InvalidateRect(hWnd, nullptr, true);
 
+      // Build scene hierarchy before rendering
+      Scene.Build();
+
       DWORD Thid;
       HANDLE RenderThreadHandle = CreateThread(0, 0, RenderThread, this, 0, &Thid);
     } /* End of  */
@@ -263,24 +297,16 @@ namespace gort
       switch (Key)
       {
       case 'W':
-        Cam.Move(vec3(Cam.Dir[0], 0, Cam.Dir[2]));
-        Render();
-        InvalidateRect(hWnd, nullptr, true);
+        MoveCamera(vec3(Cam.Dir[0], 0, Cam.Dir[2]));
         break;
       case 'S':
-        Cam.Move(-vec3(Cam.Dir[0], 0, Cam.Dir[2]));
-        Render();
-        InvalidateRect(hWnd, nullptr, true);
+        MoveCamera(-vec3(Cam.Dir[0], 0, Cam.Dir[2]));
         break;
       case 'A':
-        Cam.Move(-vec3(Cam.Right[0], 0, Cam.Right[2]));
-        Render();
-        InvalidateRect(hWnd, nullptr, true);
+        MoveCamera(-vec3(Cam.Right[0], 0, Cam.Right[2]));
         break;
       case 'D':
-        Cam.Move(vec3(Cam.Right[0], 0, Cam.Right[2]));
-        Render();
-        InvalidateRect(hWnd, nullptr, true);
+        MoveCamera(vec3(Cam.Right[0], 0, Cam.Right[2]));
         break;
       }
     } /* End of 'Keyboard' function */
@@ -294,7 +320,7 @@ namespace gort
  *       HINSTANCE hInstance;
  *   - dummy handle of previous application instance (not used):
  *       HINSTANCE hPrevInstance;
- *   - command line string:
+ *   - command line string (rendering threads count, all cores by default):
  *       CHAR *CmdLine;
  *   - show window command parameter (see SW_***):
  *       INT CmdShow;
@@ -303,7 +329,8 @@ namespace gort
  */
 INT WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, CHAR *CmdLine, INT CmdShow )
 {
-  gort::raytracer rt;
+  // Command line may contain rendering threads count
+  gort::raytracer rt(atoi(CmdLine));
   gort::surface Mtl(gort::vec3(0.4, 0.2, 0.8), gort::vec3(0.3, 0.1, 0.89), gort::vec3(0.4, 0.2, 0.9), 1, 0.4, 0.9);
   gort::surface Mtl1(gort::vec3(0.1), gort::vec3(0.8), gort::vec3(0.2), 1, 0.9, 0.1);
   //gort::surface Mtl2(gort::vec3(0.47), gort::vec3(0.6), gort::vec3(0.8), 1, 0.9, 0.9);
@@ -13,6 +13,7 @@
 #include "mth_matr.h"
 #include "mth_camera.h"
 #include "mth_ray.h"
+#include "mth_rnd.h"
 
 #endif /* __mth_h_ */
 
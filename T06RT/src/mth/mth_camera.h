@@ -195,7 +195,7 @@ namespace mth
        * RETURNS:
        *   (ray<type>) result ray.
        */
-      ray<type> FrameRay( const type &Sx, const type &Sy)
+      ray<type> FrameRay( const type &Sx, const type &Sy ) const
       {
         /* Obtain ray direction */
         vec3<type> A = Dir * ProjDist;
@@ -22,17 +22,17 @@ namespace mth
     mutable bool IsInverseEvaluated;
 
     /* Calculate inversed matrix function.
+     * Result is cached in 'InvA' until matrix is changed.
      * ARGUMENTS: None.
-     * RETURNS:
-     *   (matr) inversed matrix.
+     * RETURNS: None.
      */
-    matr EvaluateInverseMatrix( VOID ) const
+    VOID EvaluateInverseMatrix( VOID ) const
     {
       if (IsInverseEvaluated)
-        return InvA;
+        return;
       IsInverseEvaluated = TRUE;
 
-      Type det = M.Determ();
+      Type det = Determ();
 
       /* build adjoint matrix */
       InvA[0][0] =
@@ -154,10 +154,10 @@ namespace mth
 
     matr( Type A[4][4] ) : IsInverseEvaluated(FALSE)
     {
-      M[0][0] = A[0][0], M[0][1] = A[0][0], M[0][2] = A[0][0], M[0][3] = A[0][0];
-      M[1][0] = A[1][0], M[1][1] = A[1][0], M[1][2] = A[1][0], M[1][3] = A[1][0];
-      M[2][0] = A[2][0], M[2][1] = A[2][0], M[2][2] = A[2][0], M[2][3] = A[2][0];
-      M[3][0] = A[3][0], M[3][1] = A[3][0], M[3][2] = A[3][0], M[3][3] = A[3][0];
+      M[0][0] = A[0][0], M[0][1] = A[0][1], M[0][2] = A[0][2], M[0][3] = A[0][3];
+      M[1][0] = A[1][0], M[1][1] = A[1][1], M[1][2] = A[1][2], M[1][3] = A[1][3];
+      M[2][0] = A[2][0], M[2][1] = A[2][1], M[2][2] = A[2][2], M[2][3] = A[2][3];
+      M[3][0] = A[3][0], M[3][1] = A[3][1], M[3][2] = A[3][2], M[3][3] = A[3][3];
     }
 
     matr operator*( const matr &M ) const
@@ -187,6 +187,32 @@ namespace mth
                      N.X * InvA[2][0] + N.Y * InvA[2][1] + N.Z * InvA[2][2]);
     } /* End of 'TransformNormal' function */
 
+    /* Transform vector by transposed matrix function.
+     * Normals are transformed so by the inverse of the points matrix.
+     * ARGUMENTS:
+     *   - vector to be transformed:
+     *       vec3 &V;
+     * RETURNS:
+     *   (vec3) result vector.
+     */
+    vec3<Type> TransposedVectorTransform( const vec3<Type> &V ) const
+    {
+      return vec3<Type>(V.X * M[0][0] + V.Y * M[0][1] + V.Z * M[0][2],
+                        V.X * M[1][0] + V.Y * M[1][1] + V.Z * M[1][2],
+                        V.X * M[2][0] + V.Y * M[2][1] + V.Z * M[2][2]);
+    } /* End of 'TransposedVectorTransform' function */
+
+    /* Obtain inversed matrix function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (matr) inversed matrix.
+     */
+    matr Inverse( VOID ) const
+    {
+      EvaluateInverseMatrix();
+      return matr(InvA);
+    } /* End of 'Inverse' function */
+
     /* Transform point position.
      * ARGUMENTS:
      *   - point to be transformed:
@@ -370,7 +396,7 @@ namespace mth
      * RETURNS:
      *   (Type) result determ.
      */
-    Type Determ( VOID )
+    Type Determ( VOID ) const
     {
       return
         M[0][0] * Determ3x3(M[1][1], M[1][2], M[1][3],
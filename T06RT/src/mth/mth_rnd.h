@@ -0,0 +1,139 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : mth_rnd.h
+ * PURPOSE     : Ray tracing project.
+ *               Mathematics library.
+ *               Counter based random numbers streams.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'mth'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __mth_rnd_h_
+#define __mth_rnd_h_
+
+#include <atomic>
+
+#include "mthdef.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Counter based random numbers stream class.
+   * Number 'i' of a stream is a bijective mix of stream key and 'i'
+   * (SplitMix64 finalizer), so it has no shared state: a stream keyed by
+   * pixel and sample gives the same numbers in any thread and order. */
+  class rnd
+  {
+  private:
+    UINT64 Key;      // Stream key
+    UINT64 Counter;  // Next number index
+
+  public:
+    /* Stream constructor.
+     * ARGUMENTS:
+     *   - stream key:
+     *       UINT64 Key;
+     */
+    explicit rnd( UINT64 Key = 0 ) : Key(Mix(Key)), Counter(0)
+    {
+    } /* End of 'rnd' constructor */
+
+    /* Pixel sample stream constructor.
+     * ARGUMENTS:
+     *   - pixel coordinates:
+     *       INT X, Y;
+     *   - sample index:
+     *       UINT64 Sample;
+     *   - stream purpose (different numbers for other uses of the sample):
+     *       UINT64 Stream;
+     */
+    rnd( INT X, INT Y, UINT64 Sample, UINT64 Stream = 0 ) :
+      Key(Mix(Mix(Mix(static_cast<DWORD>(X) | static_cast<UINT64>(static_cast<DWORD>(Y)) << 32) ^ Sample) ^ Stream)),
+      Counter(0)
+    {
+    } /* End of 'rnd' constructor */
+
+    /* Mix 64 bit number function.
+     * ARGUMENTS:
+     *   - number:
+     *       UINT64 X;
+     * RETURNS:
+     *   (UINT64) mixed number.
+     */
+    static UINT64 Mix( UINT64 X )
+    {
+      X += 0x9E3779B97F4A7C15ull;
+      X = (X ^ X >> 30) * 0xBF58476D1CE4E5B9ull;
+      X = (X ^ X >> 27) * 0x94D049BB133111EBull;
+      return X ^ X >> 31;
+    } /* End of 'Mix' function */
+
+    /* Obtain stream number by index function.
+     * ARGUMENTS:
+     *   - number index:
+     *       UINT64 Index;
+     * RETURNS:
+     *   (UINT64) random number.
+     */
+    UINT64 Get( UINT64 Index ) const
+    {
+      return Mix(Key + Index * 0x9E3779B97F4A7C15ull);
+    } /* End of 'Get' function */
+
+    /* Obtain next stream number function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) random number.
+     */
+    UINT64 Next( VOID )
+    {
+      return Get(Counter++);
+    } /* End of 'Next' function */
+
+    /* Obtain random number from 0 to 1 (exclusive) function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) random number.
+     */
+    DBL Rnd0( VOID )
+    {
+      return (Next() >> 11) * (1.0 / 9007199254740992.0);
+    } /* End of 'Rnd0' function */
+
+    /* Obtain random number from -1 to 1 function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) random number.
+     */
+    DBL Rnd1( VOID )
+    {
+      return Rnd0() * 2 - 1;
+    } /* End of 'Rnd1' function */
+
+    /* Obtain calling thread stream function.
+     * Every thread gets its own stream, so no lock is taken (unlike
+     * 'rand'), but numbers depend on threads start order.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (rnd &) thread stream.
+     */
+    static rnd & Thread( VOID )
+    {
+      static std::atomic<UINT64> Threads {0};
+      thread_local rnd Stream(Threads++);
+
+      return Stream;
+    } /* End of 'Thread' function */
+  }; /* End of 'rnd' class */
+} /* end of 'mth' namespace */
+
+#endif /* __mth_rnd_h_ */
+
+/* END OF 'mth_rnd.h' FILE */
@@ -23,6 +23,7 @@
 #include <cstdlib>
 
 #include "mthdef.h"
+#include "mth_rnd.h"
 
 /* Space math namespace */
 namespace mth
@@ -228,25 +229,29 @@ namespace mth
     } /* end of 'Zero' funciton */
 
     /* Random vector from 0 to 1 function
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - random numbers stream (calling thread stream by default):
+     *       rnd &Rnd;
      * RETURNS:
      *   (vec2) result vector.
      */
-    vec2 Rnd0( VOID )
+    vec2 Rnd0( rnd &Rnd = rnd::Thread() )
     {
-      return *this = vec2(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX));
+      return *this = vec2(static_cast<Type>(Rnd.Rnd0()),
+	                  static_cast<Type>(Rnd.Rnd0()));
     } /* end of 'Rnd0' funciton */
 
     /* Random vector from -1 to 1 function
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - random numbers stream (calling thread stream by default):
+     *       rnd &Rnd;
      * RETURNS:
      *   (vec2) result vector.
      */
-    vec2 Rnd1( VOID )
+    vec2 Rnd1( rnd &Rnd = rnd::Thread() )
     {
-      return *this = vec2(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1));
+      return *this = vec2(static_cast<Type>(Rnd.Rnd1()),
+	                  static_cast<Type>(Rnd.Rnd1()));
     } /* end of 'Rnd1' funciton */
 
     /* Get axes by num in arr operator function
@@ -254,18 +259,16 @@ namespace mth
      *   - num in vec array:
      *       const INT N;
      * RETURNS:
-     *   (vec2) result vector.
+     *   (Type &) vector component.
      */
-    vec2 & operator[]( const INT N )
+    Type & operator[]( const INT N )
     {
       switch (N)
       {
       case 0:
 	return X;
-      case 1:
-	return Y;
       default:
-	return nullptr;
+	return Y;
       }
     } /* end of '[]' funciton */
 
@@ -274,18 +277,16 @@ namespace mth
      *   - num in vec array:
      *       const INT N;
      * RETURNS:
-     *   (vec2) result vector.
+     *   (Type) vector component.
      */
-    vec2 operator[]( const INT N ) const
+    Type operator[]( const INT N ) const
     {
       switch (N)
       {
       case 0:
         return X;
-      case 1:
-        return Y;
       default:
-	return nullptr;
+        return Y;
       }
     } /* end of '[]' funciton */
 
@@ -11,6 +11,7 @@
 #include <cstdlib>
 
 #include "mthdef.h"
+#include "mth_rnd.h"
 
 /* Space math namespace */
 namespace mth
@@ -169,19 +170,19 @@ namespace mth
 
     /* Random vector from 0 to 1 function */
 
-    vec3 Rnd0( VOID )
+    vec3 Rnd0( rnd &Rnd = rnd::Thread() )
     {
-      return *this = vec3(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX));
+      return *this = vec3(static_cast<Type>(Rnd.Rnd0()),
+	                  static_cast<Type>(Rnd.Rnd0()),
+	                  static_cast<Type>(Rnd.Rnd0()));
     } /* end of 'Rnd0' funciton */
 
     /* Random vector from -1 to 1 function */
-    vec3 Rnd1( VOID )
+    vec3 Rnd1( rnd &Rnd = rnd::Thread() )
     {
-      return *this = vec3(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-	                  static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1));
+      return *this = vec3(static_cast<Type>(Rnd.Rnd1()),
+	                  static_cast<Type>(Rnd.Rnd1()),
+	                  static_cast<Type>(Rnd.Rnd1()));
     } /* end of 'Rnd1' funciton */
 
     /* Get axes by num in arr operator function */
@@ -193,10 +194,8 @@ namespace mth
 	return X;
       case 1:
 	return Y;
-      case 2:
-	return Z;
       default:
-	return vec3(0)[0];
+	return Z;
       }
     } /* end of '[]' funciton */
 
@@ -209,10 +208,8 @@ namespace mth
 	return X;
       case 1:
 	return Y;
-      case 2:
-	return Z;
       default:
-	return vec3(0)[0];
+	return Z;
       }
     } /* end of '[]' funciton */
 
@@ -235,12 +232,9 @@ namespace mth
      */
     VOID MinBB( const vec3 &V2 )
     {
-      if (X > V2.X)
-	X = V2.X;
-      if (Y > V2.Y)
-	Y = V2.Y;
-      if (Z > V2.Z)
-	Z = V2.Z;
+      X = V2.X < X ? V2.X : X;
+      Y = V2.Y < Y ? V2.Y : Y;
+      Z = V2.Z < Z ? V2.Z : Z;
     } /* End of 'MinBB' function */
 
     /* Max bound box vector function.
@@ -252,12 +246,9 @@ namespace mth
      */
     VOID MaxBB( const vec3 &V2 )
     {
-      if (X < V2.X)
-	X = V2.X;
-      if (Y < V2.Y)
-	Y = V2.Y;
-      if (Z < V2.Z)
-	Z = V2.Z;
+      X = V2.X > X ? V2.X : X;
+      Y = V2.Y > Y ? V2.Y : Y;
+      Z = V2.Z > Z ? V2.Z : Z;
     } /* End of 'MaxBB' function */
   };
 }
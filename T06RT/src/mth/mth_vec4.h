@@ -23,6 +23,7 @@
 #include <cstdlib>
 
 #include "mthdef.h"
+#include "mth_rnd.h"
 
 /* Space math namespace */
 namespace mth
@@ -228,16 +229,18 @@ namespace mth
     } /* end of 'Zero' funciton */
 
     /* Random vector from 0 to 1 function
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - random numbers stream (calling thread stream by default):
+     *       rnd &Rnd;
      * RETURNS:
      *   (vec4) result vector.
      */
-    static vec4 Rnd0( VOID )
+    static vec4 Rnd0( rnd &Rnd = rnd::Thread() )
     {
-      return vec4(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-        static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-        static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX),
-        static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX));
+      return vec4(static_cast<Type>(Rnd.Rnd0()),
+        static_cast<Type>(Rnd.Rnd0()),
+        static_cast<Type>(Rnd.Rnd0()),
+        static_cast<Type>(Rnd.Rnd0()));
     } /* end of 'Rnd0' funciton */
 
     /* Random vector from 0 to 1 function
@@ -254,16 +257,18 @@ namespace mth
     } /* end of 'Rnd0' funciton */
 
     /* Random vector from -1 to 1 function
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - random numbers stream (calling thread stream by default):
+     *       rnd &Rnd;
      * RETURNS:
      *   (vec4) result vector.
      */
-    vec4 Rnd1( VOID )
+    vec4 Rnd1( rnd &Rnd = rnd::Thread() )
     {
-      return *this = vec4(static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-                          static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-                          static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1),
-                          static_cast<Type>(static_cast<DBL>(rand()) / RAND_MAX * 2 - 1));
+      return *this = vec4(static_cast<Type>(Rnd.Rnd1()),
+                          static_cast<Type>(Rnd.Rnd1()),
+                          static_cast<Type>(Rnd.Rnd1()),
+                          static_cast<Type>(Rnd.Rnd1()));
     } /* end of 'Rnd1' funciton */
 
     /* Get axes by num in arr operator function
@@ -7,7 +7,11 @@
 #ifndef __mthdef_h_
 #define __mthdef_h_
 
-#include <commondf.h>
+#ifdef _WIN32
+# include <commondf.h>
+#else /* _WIN32 */
+# include "../posixdf.h"
+#endif /* _WIN32 */
 
 typedef DOUBLE DBL;
 typedef FLOAT FLT;
@@ -65,9 +69,9 @@ namespace mth
   {
     DWORD Color = 0;
   
-    Color |= (DWORD)Clamp(V[0] * 255, 0.0, 255.0);
-    Color |= (DWORD)Clamp(V[1] * 255, 0.0, 255.0) << 8;
-    Color |= (DWORD)Clamp(V[2] * 255, 0.0, 255.0) << 16;
+    Color |= (DWORD)Clamp<type>(V[0] * 255, 0, 255);
+    Color |= (DWORD)Clamp<type>(V[1] * 255, 0, 255) << 8;
+    Color |= (DWORD)Clamp<type>(V[2] * 255, 0, 255) << 16;
   
     return Color;
   } /* End of 'ToRGB' function */
@@ -0,0 +1,76 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : posixdf.h
+ * PURPOSE     : Ray tracing project.
+ *               Common types declaration module for non-Windows
+ *               (headless) builds, replaces <commondf.h>.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __posixdf_h_
+#define __posixdf_h_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#define VOID void
+
+#ifndef TRUE
+# define TRUE 1
+#endif /* TRUE */
+#ifndef FALSE
+# define FALSE 0
+#endif /* FALSE */
+
+typedef char CHAR;
+typedef int INT;
+typedef unsigned int UINT;
+typedef int BOOL;
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef int64_t INT64;
+typedef uint64_t UINT64;
+typedef float FLOAT;
+typedef double DOUBLE;
+
+#define CopyMemory(Dst, Src, Size) memcpy((Dst), (Src), (Size))
+
+/* Minimum of two values function (like Windows 'min' macro).
+ * ARGUMENTS:
+ *   - values to be compared:
+ *       A a; B b;
+ * RETURNS:
+ *   (common type) minimal value.
+ */
+template<typename A, typename B>
+  inline typename std::common_type<A, B>::type min( A a, B b )
+  {
+    return a < b ? a : b;
+  } /* End of 'min' function */
+
+/* Maximum of two values function (like Windows 'max' macro).
+ * ARGUMENTS:
+ *   - values to be compared:
+ *       A a; B b;
+ * RETURNS:
+ *   (common type) maximal value.
+ */
+template<typename A, typename B>
+  inline typename std::common_type<A, B>::type max( A a, B b )
+  {
+    return a > b ? a : b;
+  } /* End of 'max' function */
+
+#endif /* __posixdf_h_ */
+
+/* END OF 'posixdf.h' FILE */
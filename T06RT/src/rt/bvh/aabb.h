@@ -0,0 +1,194 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+ 
+/* FILE NAME   : aabb.h
+ * PURPOSE     : Ray tracing project.
+ *               Axis aligned bounding box handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __aabb_h_
+#define __aabb_h_
+
+#include <limits>
+
+#include "../../def.h"
+#include "../packet/packet.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Axis aligned bounding box class */
+  class aabb
+  {
+  public:
+    vec3 Min, Max; // Box corners
+
+    /* Default constructor (empty box) */
+    aabb( VOID ) : Min(HUGE_VAL), Max(-HUGE_VAL)
+    {
+    } /* End of 'aabb' function */
+
+    /* Bounding box class constructor
+     * ARGUMENTS:
+     *   - box corners:
+     *     const vec3 &NewMin, &NewMax;
+     */
+    aabb( const vec3 &NewMin, const vec3 &NewMax ) : Min(NewMin), Max(NewMax)
+    {
+    } /* End of 'aabb' function */
+
+    /* Extend box by point function.
+     * ARGUMENTS:
+     *   - point to be included:
+     *      const vec3 &P;
+     * RETURNS: None.
+     */
+    VOID Grow( const vec3 &P )
+    {
+      Min.MinBB(P);
+      Max.MaxBB(P);
+    } /* End of 'Grow' function */
+
+    /* Extend box by other box function.
+     * ARGUMENTS:
+     *   - box to be included:
+     *      const aabb &BB;
+     * RETURNS: None.
+     */
+    VOID Grow( const aabb &BB )
+    {
+      Min.MinBB(BB.Min);
+      Max.MaxBB(BB.Max);
+    } /* End of 'Grow' function */
+
+    /* Obtain box center function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (vec3) box center.
+     */
+    vec3 Center( VOID ) const
+    {
+      return (Min + Max) * 0.5;
+    } /* End of 'Center' function */
+
+    /* Obtain box surface area function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (REAL) box surface area (0 for empty box).
+     */
+    REAL Area( VOID ) const
+    {
+      vec3 d = Max - Min;
+
+      if (d[0] < 0 || d[1] < 0 || d[2] < 0)
+        return 0;
+      return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+    } /* End of 'Area' function */
+
+    /* Obtain distance from point to box function.
+     * ARGUMENTS:
+     *   - point:
+     *      const vec3 &P;
+     * RETURNS:
+     *   (REAL) distance to the closest box point (0 inside box).
+     */
+    REAL Dist( const vec3 &P ) const
+    {
+      REAL d2 = 0;
+
+      for (INT i = 0; i < 3; i++)
+      {
+        REAL d = max(Min[i] - P[i], P[i] - Max[i]);
+
+        if (d > 0)
+          d2 += d * d;
+      }
+      return sqrt(d2);
+    } /* End of 'Dist' function */
+
+    /* Is ray crossing with box (slab test) function.
+     * ARGUMENTS:
+     *   - ray origin:
+     *      const vec3 &Org;
+     *   - inversed ray direction:
+     *      const vec3 &InvDir;
+     *   - maximal ray distance:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if ray segment [0, MaxT] crosses the box.
+     */
+    BOOL Intersect( const vec3 &Org, const vec3 &InvDir, REAL MaxT ) const
+    {
+      const REAL *mn = Min, *mx = Max, *o = Org, *id = InvDir;
+      REAL tnear = 0, tfar = MaxT;
+
+      for (INT i = 0; i < 3; i++)
+      {
+        REAL
+          t0 = (mn[i] - o[i]) * id[i],
+          t1 = (mx[i] - o[i]) * id[i];
+
+        if (t0 > t1)
+          mth::Swap(t0, t1);
+        // conservative far distance to keep hits lying on box faces
+        t1 *= 1 + 4 * std::numeric_limits<REAL>::epsilon();
+        if (t0 > tnear)
+          tnear = t0;
+        if (t1 < tfar)
+          tfar = t1;
+        if (tnear > tfar)
+          return FALSE;
+      }
+      return TRUE;
+    } /* End of 'Intersect' function */
+
+    /* Is rays packet crossing with box function.
+     * ARGUMENTS:
+     *   - rays packet (current hit distances limit segments):
+     *      const packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS:
+     *   (UINT) mask of lanes crossing the box.
+     */
+    UINT Intersect( const packet &P, UINT Mask ) const
+    {
+      REAL tnear[PacketSize], tfar[PacketSize];
+      UINT Res = 0;
+
+      for (INT j = 0; j < PacketSize; j++)
+        tnear[j] = 0, tfar[j] = P.T[j];
+      for (INT i = 0; i < 3; i++)
+      {
+        REAL mn = Min[i], mx = Max[i];
+
+        for (INT j = 0; j < PacketSize; j++)
+        {
+          REAL
+            t0 = (mn - P.Org[i][j]) * P.InvDir[i][j],
+            t1 = (mx - P.Org[i][j]) * P.InvDir[i][j],
+            tmin = t0 < t1 ? t0 : t1,
+            tmax = (t0 < t1 ? t1 : t0) * (1 + 4 * std::numeric_limits<REAL>::epsilon());
+
+          tnear[j] = tmin > tnear[j] ? tmin : tnear[j];
+          tfar[j] = tmax < tfar[j] ? tmax : tfar[j];
+        }
+      }
+      for (INT j = 0; j < PacketSize; j++)
+        Res |= (tnear[j] <= tfar[j]) << j;
+      return Res & Mask;
+    } /* End of 'Intersect' function */
+  }; /* End of 'aabb' class */
+} /* end of 'gort' namespace */
+
+#endif /* __aabb_h_ */
+
+/* END OF 'aabb.h' FILE */
@@ -0,0 +1,567 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : bvh.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Bounding volume hierarchy class functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "../render/pool.h"
+#include "bvh.h"
+
+/* Surface area heuristic costs */
+static const DBL
+  TraversalCost = 0.125, // node traversal cost relative to primitive test
+  IntersectCost = 1;     // primitive test cost
+
+/* Binned builder bins count */
+static const INT BinCount = 16;
+
+/* Morton builder maximal primitives in leaf */
+static const INT MortonLeafPrims = 4;
+
+/* Smallest subtree built as separate task */
+static const INT MinTaskPrims = 4096;
+
+/* Hierarchy builder class.
+ * All modes share one top down recursion and differ by split rule only:
+ * split returns the middle of primitive range (primitives are reordered
+ * around it) or -1 for leaf. Top levels are built to a small tree with
+ * task references in place of subtrees, tasks are built to own node
+ * arrays, then everything is joined to depth first order. Primitive
+ * references are moved instead of indices, so every pass over a range
+ * reads memory sequentially. */
+class bvh_builder
+{
+public:
+  /* Primitive reference class */
+  class ref
+  {
+  public:
+    gort::aabb BB;  // Primitive box
+    gort::vec3 C;   // Box center
+    INT Prim;       // Primitive index
+  }; /* End of 'ref' class */
+
+  /* Subtree task class */
+  class task
+  {
+  public:
+    INT Begin, End, Depth;              // Primitives range and tree depth
+    std::vector<gort::bvh::node> Nodes; // Built subtree (offsets are local)
+  }; /* End of 'task' class */
+
+  std::vector<ref> Refs;                // Primitive references
+  std::vector<UINT> Codes;              // Morton codes in references order (LBVH mode only)
+  gort::bvh::mode Mode;                 // Build mode
+  std::vector<task> Tasks;              // Subtree tasks
+  INT TaskPrims = 0;                    // Largest range built as single task
+
+  /* Builder constructor.
+   * ARGUMENTS:
+   *   - primitive boxes:
+   *      const std::vector<gort::aabb> &Boxes;
+   *   - build mode:
+   *      gort::bvh::mode NewMode;
+   */
+  bvh_builder( const std::vector<gort::aabb> &Boxes, gort::bvh::mode NewMode ) : Refs(Boxes.size()), Mode(NewMode)
+  {
+    for (size_t i = 0; i < Boxes.size(); i++)
+      Refs[i] = ref {Boxes[i], Boxes[i].Center(), static_cast<INT>(i)};
+    if (Mode == gort::bvh::LBVH)
+      SortMorton();
+  } /* End of 'bvh_builder' function */
+
+  /* Spread 10 bits to every third bit function.
+   * ARGUMENTS:
+   *   - value:
+   *      UINT X;
+   * RETURNS:
+   *   (UINT) spread bits.
+   */
+  static UINT SpreadBits( UINT X )
+  {
+    X = (X | (X << 16)) & 0x030000FF;
+    X = (X | (X << 8)) & 0x0300F00F;
+    X = (X | (X << 4)) & 0x030C30C3;
+    X = (X | (X << 2)) & 0x09249249;
+    return X;
+  } /* End of 'SpreadBits' function */
+
+  /* Order references by Morton codes of centers function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID SortMorton( VOID )
+  {
+    INT Count = static_cast<INT>(Refs.size());
+    gort::aabb CB;
+    std::vector<UINT64> Keys(Count);
+    std::vector<ref> Sorted(Count);
+
+    for (auto &R : Refs)
+      CB.Grow(R.C);
+
+    // same scale for all axes: flat scenes are not split along thin axis first
+    gort::vec3 Size = CB.Max - CB.Min;
+    DBL Side = max(max(Size[0], Size[1]), Size[2]), Scale = Side > 0 ? 1023.0 / Side : 0;
+
+    for (INT i = 0; i < Count; i++)
+    {
+      gort::vec3 P = Refs[i].C - CB.Min;
+      UINT Code =
+        SpreadBits(static_cast<UINT>(P[0] * Scale)) << 2 |
+        SpreadBits(static_cast<UINT>(P[1] * Scale)) << 1 |
+        SpreadBits(static_cast<UINT>(P[2] * Scale));
+
+      Keys[i] = static_cast<UINT64>(Code) << 32 | static_cast<UINT>(i);
+    }
+    std::sort(Keys.begin(), Keys.end());
+
+    Codes.resize(Count);
+    for (INT i = 0; i < Count; i++)
+    {
+      Codes[i] = static_cast<UINT>(Keys[i] >> 32);
+      Sorted[i] = Refs[Keys[i] & 0xFFFFFFFF];
+    }
+    Refs.swap(Sorted);
+  } /* End of 'SortMorton' function */
+
+  /* Obtain reference center coordinate function.
+   * ARGUMENTS:
+   *   - primitive reference:
+   *      const ref &R;
+   *   - axis:
+   *      INT Axis;
+   * RETURNS:
+   *   (gort::REAL) coordinate.
+   */
+  static gort::REAL Center( const ref &R, INT Axis )
+  {
+    return static_cast<const gort::REAL *>(R.C)[Axis];
+  } /* End of 'Center' function */
+
+  /* Evaluate references range bounds function.
+   * ARGUMENTS:
+   *   - references range:
+   *      INT Begin, End;
+   *   - boxes and centers bounds pointers:
+   *      gort::aabb *BB, *CB;
+   * RETURNS: None.
+   */
+  VOID Bound( INT Begin, INT End, gort::aabb *BB, gort::aabb *CB ) const
+  {
+    for (INT i = Begin; i < End; i++)
+    {
+      BB->Grow(Refs[i].BB);
+      CB->Grow(Refs[i].C);
+    }
+  } /* End of 'Bound' function */
+
+  /* Check if split is not cheaper than leaf function.
+   * ARGUMENTS:
+   *   - primitives count:
+   *      INT Count;
+   *   - best split cost (areas times counts, HUGE_VAL for none):
+   *      DBL BestCost;
+   *   - range box area:
+   *      DBL Area;
+   * RETURNS:
+   *   (BOOL) TRUE if range should become leaf.
+   */
+  static BOOL IsLeafCheaper( INT Count, DBL BestCost, DBL Area )
+  {
+    return Count <= gort::bvh::MaxLeafPrims &&
+      (BestCost == HUGE_VAL || Area <= 0 || TraversalCost + IntersectCost * BestCost / Area >= IntersectCost * Count);
+  } /* End of 'IsLeafCheaper' function */
+
+  /* Split by all positions sweep function.
+   * ARGUMENTS:
+   *   - primitive indices range:
+   *      INT Begin, End;
+   *   - split axis pointer:
+   *      INT *Axis;
+   * RETURNS:
+   *   (INT) split position (-1 for leaf).
+   */
+  INT SplitSweep( INT Begin, INT End, INT *Axis )
+  {
+    INT Count = End - Begin;
+    gort::aabb BB, CB;
+
+    Bound(Begin, End, &BB, &CB);
+
+    // Sweep all split positions along every axis
+    std::vector<DBL> RightArea(Count);
+    DBL BestCost = HUGE_VAL;
+    INT BestAxis = -1, BestSplit = Count / 2;
+
+    for (INT A = 0; A < 3; A++)
+    {
+      if (CB.Max[A] - CB.Min[A] <= 0)
+        continue;
+
+      std::sort(Refs.begin() + Begin, Refs.begin() + End,
+        [A]( const ref &R0, const ref &R1 )
+        {
+          return Center(R0, A) < Center(R1, A);
+        });
+
+      gort::aabb Left, Right;
+
+      for (INT i = Count - 1; i > 0; i--)
+      {
+        Right.Grow(Refs[Begin + i].BB);
+        RightArea[i] = Right.Area();
+      }
+      for (INT i = 1; i < Count; i++)
+      {
+        Left.Grow(Refs[Begin + i - 1].BB);
+
+        DBL Cost = Left.Area() * i + RightArea[i] * (Count - i);
+
+        if (Cost < BestCost)
+          BestCost = Cost, BestAxis = A, BestSplit = i;
+      }
+    }
+
+    // Make leaf if split is not cheaper than primitives testing
+    if (IsLeafCheaper(Count, BestCost, BB.Area()))
+      return -1;
+
+    // Restore order along the chosen axis (degenerate ranges are split by half)
+    if (BestAxis >= 0)
+      std::nth_element(Refs.begin() + Begin, Refs.begin() + Begin + BestSplit, Refs.begin() + End,
+        [BestAxis]( const ref &R0, const ref &R1 )
+        {
+          return Center(R0, BestAxis) < Center(R1, BestAxis);
+        });
+    *Axis = BestAxis >= 0 ? BestAxis : 0;
+    return Begin + BestSplit;
+  } /* End of 'SplitSweep' function */
+
+  /* Split by centroid bins function.
+   * Every primitive is put to bin of every axis in one pass, bin
+   * borders are the only split candidates.
+   * ARGUMENTS:
+   *   - primitive indices range:
+   *      INT Begin, End;
+   *   - split axis pointer:
+   *      INT *Axis;
+   * RETURNS:
+   *   (INT) split position (-1 for leaf).
+   */
+  INT SplitBinned( INT Begin, INT End, INT *Axis )
+  {
+    INT Count = End - Begin;
+    gort::aabb BB, CB;
+
+    Bound(Begin, End, &BB, &CB);
+
+    gort::aabb Bins[3][BinCount];
+    INT Counts[3][BinCount] = {};
+    DBL Scale[3];
+
+    for (INT A = 0; A < 3; A++)
+    {
+      DBL Size = CB.Max[A] - CB.Min[A];
+
+      Scale[A] = Size > 0 ? BinCount * (1 - 1e-6) / Size : 0;
+    }
+
+    auto BinOf = [&]( const ref &R, INT A )
+    {
+      return static_cast<INT>((Center(R, A) - CB.Min[A]) * Scale[A]);
+    };
+
+    for (INT i = Begin; i < End; i++)
+      for (INT A = 0; A < 3; A++)
+      {
+        INT B = BinOf(Refs[i], A);
+
+        Bins[A][B].Grow(Refs[i].BB);
+        Counts[A][B]++;
+      }
+
+    // Sweep bin borders
+    DBL BestCost = HUGE_VAL;
+    INT BestAxis = -1, BestBin = 0;
+
+    for (INT A = 0; A < 3; A++)
+    {
+      if (Scale[A] == 0)
+        continue;
+
+      gort::aabb Left, Right;
+      DBL RightArea[BinCount];
+      INT RightCount[BinCount], N = 0;
+
+      for (INT b = BinCount - 1; b > 0; b--)
+      {
+        Right.Grow(Bins[A][b]);
+        RightArea[b] = Right.Area();
+        RightCount[b] = N += Counts[A][b];
+      }
+      N = 0;
+      for (INT b = 1; b < BinCount; b++)
+      {
+        Left.Grow(Bins[A][b - 1]);
+        N += Counts[A][b - 1];
+        if (N == 0 || RightCount[b] == 0)
+          continue;
+
+        DBL Cost = Left.Area() * N + RightArea[b] * RightCount[b];
+
+        if (Cost < BestCost)
+          BestCost = Cost, BestAxis = A, BestBin = b;
+      }
+    }
+
+    if (IsLeafCheaper(Count, BestCost, BB.Area()))
+      return -1;
+
+    // Equal centers are split by half
+    if (BestAxis < 0)
+    {
+      *Axis = 0;
+      return Begin + Count / 2;
+    }
+    *Axis = BestAxis;
+    return static_cast<INT>(std::partition(Refs.begin() + Begin, Refs.begin() + End,
+      [&]( const ref &R )
+      {
+        return BinOf(R, BestAxis) < BestBin;
+      }) - Refs.begin());
+  } /* End of 'SplitBinned' function */
+
+  /* Split by Morton codes function.
+   * Range is split where the highest differing code bit changes.
+   * ARGUMENTS:
+   *   - primitive indices range:
+   *      INT Begin, End;
+   *   - split axis pointer:
+   *      INT *Axis;
+   * RETURNS:
+   *   (INT) split position (-1 for leaf).
+   */
+  INT SplitMorton( INT Begin, INT End, INT *Axis )
+  {
+    if (End - Begin <= MortonLeafPrims)
+      return -1;
+
+    UINT Diff = Codes[Begin] ^ Codes[End - 1];
+
+    // Equal codes are split by half
+    if (Diff == 0)
+    {
+      *Axis = 0;
+      return Begin + (End - Begin) / 2;
+    }
+
+    INT Bit = 31;
+
+    while (!(Diff & (1u << Bit)))
+      Bit--;
+    // x, y, z bits are interleaved from the highest one
+    *Axis = 2 - Bit % 3;
+    return static_cast<INT>(std::partition_point(Codes.begin() + Begin, Codes.begin() + End,
+      [Bit]( UINT Code )
+      {
+        return !(Code & (1u << Bit));
+      }) - Codes.begin());
+  } /* End of 'SplitMorton' function */
+
+  /* Split range function.
+   * ARGUMENTS:
+   *   - primitive indices range:
+   *      INT Begin, End;
+   *   - tree depth:
+   *      INT Depth;
+   *   - split axis pointer:
+   *      INT *Axis;
+   * RETURNS:
+   *   (INT) split position (-1 for leaf).
+   */
+  INT Split( INT Begin, INT End, INT Depth, INT *Axis )
+  {
+    // Leaf for small ranges and too deep trees
+    if (End - Begin <= 2 || Depth >= gort::bvh::MaxDepth)
+      return -1;
+    switch (Mode)
+    {
+    case gort::bvh::SWEEP:
+      return SplitSweep(Begin, End, Axis);
+    case gort::bvh::LBVH:
+      return SplitMorton(Begin, End, Axis);
+    default:
+      return SplitBinned(Begin, End, Axis);
+    }
+  } /* End of 'Split' function */
+
+  /* Build subtree function.
+   * ARGUMENTS:
+   *   - nodes array to be filled:
+   *      std::vector<gort::bvh::node> &Out;
+   *   - primitive indices range:
+   *      INT Begin, End;
+   *   - tree depth:
+   *      INT Depth;
+   *   - subtree tasks creation flag (top levels):
+   *      BOOL IsTop;
+   * RETURNS:
+   *   (gort::aabb) subtree box (empty for task references).
+   */
+  gort::aabb BuildRec( std::vector<gort::bvh::node> &Out, INT Begin, INT End, INT Depth, BOOL IsTop )
+  {
+    INT Index = static_cast<INT>(Out.size()), Axis = 0, Mid;
+    gort::aabb BB;
+
+    Out.push_back(gort::bvh::node());
+
+    // Task reference is kept as negative count
+    if (IsTop && End - Begin <= TaskPrims)
+    {
+      Out[Index].Count = -1 - static_cast<INT>(Tasks.size());
+      Tasks.push_back(task {Begin, End, Depth});
+      return BB;
+    }
+
+    if ((Mid = Split(Begin, End, Depth, &Axis)) < 0)
+    {
+      for (INT i = Begin; i < End; i++)
+        BB.Grow(Refs[i].BB);
+      Out[Index].BB = BB;
+      Out[Index].Offset = Begin;
+      Out[Index].Count = End - Begin;
+      return BB;
+    }
+
+    BB = BuildRec(Out, Begin, Mid, Depth + 1, IsTop);
+
+    INT Right = static_cast<INT>(Out.size());
+
+    BB.Grow(BuildRec(Out, Mid, End, Depth + 1, IsTop));
+    Out[Index].BB = BB;
+    Out[Index].Offset = Right;
+    Out[Index].Count = 0;
+    Out[Index].Axis = Axis;
+    return BB;
+  } /* End of 'BuildRec' function */
+
+  /* Join top levels with tasks subtrees function.
+   * ARGUMENTS:
+   *   - top levels nodes:
+   *      const std::vector<gort::bvh::node> &Top;
+   *   - top node index:
+   *      INT Index;
+   *   - joined nodes array:
+   *      std::vector<gort::bvh::node> &Out;
+   * RETURNS:
+   *   (gort::aabb) subtree box.
+   */
+  gort::aabb Join( const std::vector<gort::bvh::node> &Top, INT Index, std::vector<gort::bvh::node> &Out )
+  {
+    const gort::bvh::node &N = Top[Index];
+
+    if (N.Count < 0)
+    {
+      std::vector<gort::bvh::node> &Sub = Tasks[-1 - N.Count].Nodes;
+      INT Base = static_cast<INT>(Out.size());
+
+      for (auto &SN : Sub)
+      {
+        Out.push_back(SN);
+        if (SN.Count == 0)
+          Out.back().Offset += Base;
+      }
+      return Sub[0].BB;
+    }
+
+    INT My = static_cast<INT>(Out.size());
+
+    Out.push_back(N);
+    if (N.Count > 0)
+      return N.BB;
+
+    gort::aabb BB = Join(Top, Index + 1, Out);
+    INT Right = static_cast<INT>(Out.size());
+
+    BB.Grow(Join(Top, N.Offset, Out));
+    Out[My].BB = BB;
+    Out[My].Offset = Right;
+    return BB;
+  } /* End of 'Join' function */
+}; /* End of 'bvh_builder' class */
+
+/* Build hierarchy function.
+ * Top levels are split on calling thread, subtrees below them are
+ * built as separate tasks of the pool and joined in depth first order.
+ * ARGUMENTS:
+ *   - primitive bounding boxes:
+ *      const std::vector<aabb> &Boxes;
+ *   - subtree tasks pool (nullptr to build on calling thread):
+ *      pool *Pool;
+ * RETURNS: None.
+ */
+VOID gort::bvh::Build( const std::vector<aabb> &Boxes, pool *Pool )
+{
+  auto Start = std::chrono::high_resolution_clock::now();
+  INT Count = static_cast<INT>(Boxes.size());
+
+  Clear();
+  if (Count > 0)
+  {
+    bvh_builder Builder(Boxes, Mode);
+
+    Nodes.reserve(2 * Count);
+    if (Pool == nullptr || Pool->GetThreadCount() < 2 || Count < 2 * MinTaskPrims)
+      Builder.BuildRec(Nodes, 0, Count, 0, FALSE);
+    else
+    {
+      // several tasks per thread for balance
+      std::vector<node> Top;
+
+      Builder.TaskPrims = max(Count / (Pool->GetThreadCount() * 8), MinTaskPrims);
+      Builder.BuildRec(Top, 0, Count, 0, TRUE);
+      Pool->Run(static_cast<INT>(Builder.Tasks.size()),
+        [&]( INT Task, INT Worker )
+        {
+          bvh_builder::task &T = Builder.Tasks[Task];
+
+          T.Nodes.reserve(2 * (T.End - T.Begin));
+          Builder.BuildRec(T.Nodes, T.Begin, T.End, T.Depth, FALSE);
+        });
+      Builder.Join(Top, 0, Nodes);
+    }
+    Nodes.shrink_to_fit();
+    Prims.resize(Count);
+    for (INT i = 0; i < Count; i++)
+      Prims[i] = Builder.Refs[i].Prim;
+  }
+
+  // Tree statistics
+  DBL RootArea = Nodes.empty() ? 0 : Nodes[0].BB.Area();
+
+  for (auto &N : Nodes)
+  {
+    if (N.Count > 0)
+      LeafCount++;
+    if (RootArea > 0)
+      Cost += N.BB.Area() / RootArea * (N.Count > 0 ? IntersectCost * N.Count : TraversalCost);
+  }
+
+  BuildTime = std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count();
+} /* End of 'Build' function */
+
+/* END OF 'bvh.cpp' FILE */
@@ -0,0 +1,375 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : bvh.h
+ * PURPOSE     : Ray tracing project.
+ *               Bounding volume hierarchy handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __bvh_h_
+#define __bvh_h_
+
+#include <algorithm>
+#include <vector>
+
+#include "aabb.h"
+#include "../stats/stats.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  class pool;
+
+  /* Bounding volume hierarchy class.
+   * Hierarchy is built over primitive boxes only and stores primitive
+   * indices, so it is shared by the scene and by the complex shapes. */
+  class bvh
+  {
+  public:
+    /* Hierarchy node class */
+    class node
+    {
+    public:
+      aabb BB;     // Node bounding box
+      INT Offset;  // First primitive index for leaf, right child index for inner node
+      INT Count;   // Primitives count (0 for inner node)
+      INT Axis;    // Split axis (inner node only)
+    }; /* End of 'node' class */
+
+    /* Build modes */
+    enum mode
+    {
+      SWEEP,   // Surface area heuristic over all split positions (best trees, slowest)
+      BINNED,  // Surface area heuristic over centroid bins
+      LBVH     // Splits by Morton codes of centroids (fastest, for dynamic scenes)
+    };
+
+    static const INT MaxDepth = 60;     // Maximal tree depth (traversal stack size)
+    static const INT MaxLeafPrims = 8;  // Maximal primitives in leaf
+
+  private:
+    std::vector<node> Nodes;  // Nodes in depth first order (left child follows parent)
+    std::vector<INT> Prims;   // Primitive indices in leaves order
+
+    mode Mode = BINNED; // Build mode
+    DBL BuildTime = 0;  // Last build time in seconds
+    DBL Cost = 0;       // Surface area heuristic cost of last build
+    INT LeafCount = 0;  // Leaves count
+
+  public:
+    /* Build hierarchy function.
+     * Top levels are split on calling thread, subtrees below them are
+     * built as separate tasks of the pool and joined in depth first order.
+     * ARGUMENTS:
+     *   - primitive bounding boxes:
+     *      const std::vector<aabb> &Boxes;
+     *   - subtree tasks pool (nullptr to build on calling thread):
+     *      pool *Pool;
+     * RETURNS: None.
+     */
+    VOID Build( const std::vector<aabb> &Boxes, pool *Pool = nullptr );
+
+    /* Set build mode function.
+     * ARGUMENTS:
+     *   - new build mode (used by next build):
+     *      mode NewMode;
+     * RETURNS: None.
+     */
+    VOID SetMode( mode NewMode )
+    {
+      Mode = NewMode;
+    } /* End of 'SetMode' function */
+
+    /* Obtain build mode function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (mode) build mode.
+     */
+    mode GetMode( VOID ) const
+    {
+      return Mode;
+    } /* End of 'GetMode' function */
+
+    /* Renumber primitives in leaves order function.
+     * After renumbering leaves keep consecutive primitive indices, so
+     * primitive data reordered by the result is read sequentially.
+     * Primitives of every leaf are ordered by key.
+     * ARGUMENTS:
+     *   - primitive key functor (INT Key( INT Prim ), old index):
+     *      key_func Key;
+     * RETURNS:
+     *   (std::vector<INT>) old index of every new primitive index.
+     */
+    template<typename key_func>
+      std::vector<INT> Renumber( key_func Key )
+      {
+        for (auto &N : Nodes)
+          if (N.Count > 0)
+            std::stable_sort(Prims.begin() + N.Offset, Prims.begin() + N.Offset + N.Count,
+              [&]( INT A, INT B )
+              {
+                return Key(A) < Key(B);
+              });
+
+        std::vector<INT> Order(Prims);
+
+        for (INT i = 0; i < static_cast<INT>(Prims.size()); i++)
+          Prims[i] = i;
+        return Order;
+      } /* End of 'Renumber' function */
+
+    /* Clear hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID )
+    {
+      Nodes.clear();
+      Prims.clear();
+      LeafCount = 0;
+      Cost = 0;
+    } /* End of 'Clear' function */
+
+    /* Find closest primitive crossing function.
+     * ARGUMENTS:
+     *   - ray from camera:
+     *      const ray &R;
+     *   - maximal ray distance:
+     *      REAL MaxT;
+     *   - primitive intersection functor
+     *     (BOOL Isect( INT Prim, REAL &MaxT ) returns TRUE and
+     *      decreases MaxT for the closer hit):
+     *      isect_func Isect;
+     * RETURNS:
+     *   (BOOL) Is any primitive crossed.
+     */
+    template<typename isect_func>
+      BOOL Intersect( const ray &R, REAL MaxT, isect_func Isect ) const
+      {
+        if (Nodes.empty())
+          return FALSE;
+
+        vec3 InvDir(1 / R.Dir[0], 1 / R.Dir[1], 1 / R.Dir[2]);
+        BOOL DirNeg[3] = {InvDir[0] < 0, InvDir[1] < 0, InvDir[2] < 0};
+        INT Stack[MaxDepth + 1], Sp = 0, Cur = 0;
+        BOOL IsHit = FALSE;
+
+        while (TRUE)
+        {
+          const node &N = Nodes[Cur];
+
+          GORT_STAT_INC(NODE_VISITS);
+          if (N.BB.Intersect(R.Org, InvDir, MaxT))
+          {
+            if (N.Count > 0)
+            {
+              for (INT i = 0; i < N.Count; i++)
+                if (Isect(Prims[N.Offset + i], MaxT))
+                  IsHit = TRUE;
+            }
+            else
+            {
+              // visit near child first
+              if (DirNeg[N.Axis])
+                Stack[Sp++] = Cur + 1, Cur = N.Offset;
+              else
+                Stack[Sp++] = N.Offset, Cur = Cur + 1;
+              continue;
+            }
+          }
+          if (Sp == 0)
+            break;
+          Cur = Stack[--Sp];
+        }
+        return IsHit;
+      } /* End of 'Intersect' function */
+
+    /* Find any primitive crossing function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     *   - primitive occlusion functor
+     *     (BOOL Isect( INT Prim ) returns TRUE if segment is blocked):
+     *      isect_func Isect;
+     * RETURNS:
+     *   (BOOL) TRUE if segment is blocked (stops on first found primitive).
+     */
+    template<typename isect_func>
+      BOOL Occluded( const ray &R, REAL MaxT, isect_func Isect ) const
+      {
+        if (Nodes.empty())
+          return FALSE;
+
+        vec3 InvDir(1 / R.Dir[0], 1 / R.Dir[1], 1 / R.Dir[2]);
+        BOOL DirNeg[3] = {InvDir[0] < 0, InvDir[1] < 0, InvDir[2] < 0};
+        INT Stack[MaxDepth + 1], Sp = 0, Cur = 0;
+
+        while (TRUE)
+        {
+          const node &N = Nodes[Cur];
+
+          GORT_STAT_INC(NODE_VISITS);
+          if (N.BB.Intersect(R.Org, InvDir, MaxT))
+          {
+            if (N.Count > 0)
+            {
+              for (INT i = 0; i < N.Count; i++)
+                if (Isect(Prims[N.Offset + i]))
+                  return TRUE;
+            }
+            else
+            {
+              if (DirNeg[N.Axis])
+                Stack[Sp++] = Cur + 1, Cur = N.Offset;
+              else
+                Stack[Sp++] = N.Offset, Cur = Cur + 1;
+              continue;
+            }
+          }
+          if (Sp == 0)
+            break;
+          Cur = Stack[--Sp];
+        }
+        return FALSE;
+      } /* End of 'Occluded' function */
+
+    /* Find closest primitive crossings for rays packet function.
+     * ARGUMENTS:
+     *   - rays packet (hit distances are used as segment limits):
+     *      const packet &P;
+     *   - primitive packet intersection functor
+     *     (VOID Isect( INT Prim, UINT Mask ) updates closest hits
+     *      of lanes from mask):
+     *      isect_func Isect;
+     * RETURNS: None.
+     */
+    template<typename isect_func>
+      VOID Intersect( const packet &P, isect_func Isect ) const
+      {
+        if (Nodes.empty() || P.Active == 0)
+          return;
+
+        // near child order is taken from the first active lane
+        INT Lead = 0;
+
+        while (!(P.Active & (1u << Lead)))
+          Lead++;
+
+        BOOL DirNeg[3] = {P.InvDir[0][Lead] < 0, P.InvDir[1][Lead] < 0, P.InvDir[2][Lead] < 0};
+        INT Stack[MaxDepth + 1], Sp = 0, Cur = 0;
+
+        while (TRUE)
+        {
+          const node &N = Nodes[Cur];
+          UINT Mask = N.BB.Intersect(P, P.Active);
+
+          GORT_STAT_INC(PACKET_VISITS);
+          if (Mask != 0)
+          {
+            if (N.Count > 0)
+            {
+              for (INT i = 0; i < N.Count; i++)
+                Isect(Prims[N.Offset + i], Mask);
+            }
+            else
+            {
+              if (DirNeg[N.Axis])
+                Stack[Sp++] = Cur + 1, Cur = N.Offset;
+              else
+                Stack[Sp++] = N.Offset, Cur = Cur + 1;
+              continue;
+            }
+          }
+          if (Sp == 0)
+            break;
+          Cur = Stack[--Sp];
+        }
+      } /* End of 'Intersect' function */
+
+    /* Obtain nodes function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<node> &) nodes in depth first order.
+     */
+    const std::vector<node> & GetNodes( VOID ) const
+    {
+      return Nodes;
+    } /* End of 'GetNodes' function */
+
+    /* Obtain primitive indices function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<INT> &) primitive indices in leaves order.
+     */
+    const std::vector<INT> & GetPrims( VOID ) const
+    {
+      return Prims;
+    } /* End of 'GetPrims' function */
+
+    /* Obtain nodes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) nodes count.
+     */
+    INT GetNodeCount( VOID ) const
+    {
+      return static_cast<INT>(Nodes.size());
+    } /* End of 'GetNodeCount' function */
+
+    /* Obtain leaves count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) leaves count.
+     */
+    INT GetLeafCount( VOID ) const
+    {
+      return LeafCount;
+    } /* End of 'GetLeafCount' function */
+
+    /* Obtain primitives count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) primitives count.
+     */
+    INT GetPrimCount( VOID ) const
+    {
+      return static_cast<INT>(Prims.size());
+    } /* End of 'GetPrimCount' function */
+
+    /* Obtain tree quality function.
+     * Expected cost of a random ray crossing the root box: node
+     * traversals and primitive tests weighted by node areas.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) surface area heuristic cost (lower is better).
+     */
+    DBL GetCost( VOID ) const
+    {
+      return Cost;
+    } /* End of 'GetCost' function */
+
+    /* Obtain last build time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) build time in seconds.
+     */
+    DBL GetBuildTime( VOID ) const
+    {
+      return BuildTime;
+    } /* End of 'GetBuildTime' function */
+  }; /* End of 'bvh' class */
+} /* end of 'gort' namespace */
+
+#endif /* __bvh_h_ */
+
+/* END OF 'bvh.h' FILE */
@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Frame handle module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 01.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -17,25 +17,110 @@
 #ifndef __frame_h_
 #define __frame_h_
 
+#ifdef _WIN32
 #pragma pack(push, 1)
 #include <tgahead.h>
 #pragma pack(pop)
+#endif /* _WIN32 */
 
 #include <string>
 #include <fstream>
 #include <filesystem>
+#include <vector>
 
 #include "../../def.h"
 
 /* Space gort namespace */
 namespace gort
 {
-  /* Frame class */
+  /* Frame class.
+   * Linear colors are kept in float RGBA plane stored by square tiles
+   * (one tile is a run of cache lines), 32-bit present buffer is built
+   * from it by 'Present' and is used by drawing and saving without copy.
+   * Float channels order is the same as present buffer bytes order
+   * (0x00RRGGBB - blue first). */
   class frame
   {
+  public:
+    /* Plane tile side in pixels */
+    static const INT TileSide = 8;
+
   private:
-    INT W = 0, H = 0; // Frame size
-    DWORD *Pixels = nullptr; // Frame buffer pixels
+    /* Float plane tile class */
+    class alignas(64) tile
+    {
+    public:
+      FLT C[TileSide * TileSide * 4];  // Pixel colors (4 floats per pixel, rows of tile)
+    }; /* End of 'tile' class */
+
+    INT W = 0, H = 0;            // Frame size
+    INT TilesX = 0;              // Plane tiles in row
+    std::vector<tile> Plane;     // Float colors plane
+    std::vector<DWORD> Pixels;   // Present buffer pixels
+    FLT Scale = 1;               // Plane to linear colors factor (for accumulated sums)
+
+    /* Obtain pixel plane color pointer function.
+     * ARGUMENTS:
+     *   - pixel coords:
+     *       INT X, Y;
+     * RETURNS:
+     *   (FLT *) pixel 4 floats.
+     */
+    FLT * Texel( INT X, INT Y )
+    {
+      return &Plane[(Y / TileSide) * TilesX + X / TileSide].C[((Y % TileSide) * TileSide + X % TileSide) * 4];
+    } /* End of 'Texel' function */
+
+    /* Obtain pixel plane color pointer function.
+     * ARGUMENTS:
+     *   - pixel coords:
+     *       INT X, Y;
+     * RETURNS:
+     *   (const FLT *) pixel 4 floats.
+     */
+    const FLT * Texel( INT X, INT Y ) const
+    {
+      return &Plane[(Y / TileSide) * TilesX + X / TileSide].C[((Y % TileSide) * TileSide + X % TileSide) * 4];
+    } /* End of 'Texel' function */
+
+    /* Clip block by frame function.
+     * ARGUMENTS:
+     *   - block corner and size (clipped):
+     *       INT &X0, &Y0, &BW, &BH;
+     *   - block colors pointer (moved to clipped corner) and row stride:
+     *       const vec3 *&Colors; INT Stride;
+     * RETURNS:
+     *   (BOOL) TRUE if block is not empty.
+     */
+    BOOL Clip( INT &X0, INT &Y0, INT &BW, INT &BH, const vec3 *&Colors, INT Stride ) const
+    {
+      if (X0 < 0)
+        Colors -= X0, BW += X0, X0 = 0;
+      if (Y0 < 0)
+        Colors -= Y0 * Stride, BH += Y0, Y0 = 0;
+      BW = min(BW, W - X0);
+      BH = min(BH, H - Y0);
+      return BW > 0 && BH > 0;
+    } /* End of 'Clip' function */
+
+    /* Open file for buffered binary writing function.
+     * ARGUMENTS:
+     *   - file stream:
+     *       std::ofstream &F;
+     *   - stream buffer:
+     *       std::vector<CHAR> &Buf;
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if file opened.
+     */
+    static BOOL OpenOutput( std::ofstream &F, std::vector<CHAR> &Buf, const std::string &FileName )
+    {
+      Buf.resize(1 << 20);
+      F.rdbuf()->pubsetbuf(Buf.data(), Buf.size());
+      F.open(FileName, std::ofstream::out | std::ofstream::binary);
+      return F.is_open();
+    } /* End of 'OpenOutput' function */
 
   public:
     /* Obtain width function.
@@ -68,17 +153,11 @@ namespace gort
      *   - frame size:
      *     INT W, H;
      */
-    frame( INT NewW, INT NewH ) : W(NewW), H(NewH)
+    frame( INT NewW, INT NewH )
     {
-      Pixels = new DWORD[NewW * NewH];
+      Resize(NewW, NewH);
     } /* End of 'frame' function */
 
-    /* Frame class destructor */
-    ~frame( VOID )
-    {
-      delete[] Pixels;
-    } /* End of '~frame' function */
-
     /* Resize frame buffer function
      * ARGUMENTS:
      *   - frame new size:
@@ -88,10 +167,10 @@ namespace gort
     VOID Resize( INT NewW, INT NewH )
     {
       W = NewW, H = NewH;
-
-      if (Pixels != nullptr)
-	delete[] Pixels;
-      Pixels = new DWORD[NewW * NewH];
+      TilesX = (W + TileSide - 1) / TileSide;
+      Plane.assign(static_cast<size_t>(TilesX) * ((H + TileSide - 1) / TileSide), tile {});
+      Pixels.assign(static_cast<size_t>(W) * H, 0);
+      Scale = 1;
     } /* End of 'Resize' function */
 
     /* Put pixel in frame buffer function
@@ -106,12 +185,162 @@ namespace gort
     {
       // Clipping
       if (X < 0 || Y < 0 || Y >= H || X >= W)
-	return;
+        return;
 
       // Set pixel color
       Pixels[Y * W + X] = Color;
     } /* End of 'PutPixel' function */
 
+    /* Put linear color pixel in frame buffer function
+     * ARGUMENTS:
+     *   - pixel coords:
+     *       INT X, Y;
+     *   - pixel color:
+     *       const vec3 &Color;
+     * RETURNS: None.
+     */
+    VOID PutPixel( INT X, INT Y, const vec3 &Color )
+    {
+      // Clipping
+      if (X < 0 || Y < 0 || Y >= H || X >= W)
+        return;
+
+      FLT *C = Texel(X, Y);
+
+      C[0] = static_cast<FLT>(Color[0] / Scale);
+      C[1] = static_cast<FLT>(Color[1] / Scale);
+      C[2] = static_cast<FLT>(Color[2] / Scale);
+      C[3] = 1;
+      Pixels[Y * W + X] = mth::toRGB(Color);
+    } /* End of 'PutPixel' function */
+
+    /* Put block of linear colors function.
+     * Block is clipped once, present buffer is not changed.
+     * ARGUMENTS:
+     *   - block corner and size:
+     *       INT X0, Y0, BW, BH;
+     *   - block colors (by rows):
+     *       const vec3 *Colors;
+     * RETURNS: None.
+     */
+    VOID PutBlock( INT X0, INT Y0, INT BW, INT BH, const vec3 *Colors )
+    {
+      INT Stride = BW;
+
+      if (!Clip(X0, Y0, BW, BH, Colors, Stride))
+        return;
+      for (INT y = 0; y < BH; y++)
+        for (INT x = 0; x < BW; x++)
+        {
+          FLT *C = Texel(X0 + x, Y0 + y);
+          const vec3 &Src = Colors[y * Stride + x];
+
+          C[0] = static_cast<FLT>(Src[0]);
+          C[1] = static_cast<FLT>(Src[1]);
+          C[2] = static_cast<FLT>(Src[2]);
+          C[3] = 1;
+        }
+    } /* End of 'PutBlock' function */
+
+    /* Add block of linear colors to accumulated ones function.
+     * Block is clipped once, present buffer is not changed.
+     * ARGUMENTS:
+     *   - block corner and size:
+     *       INT X0, Y0, BW, BH;
+     *   - block colors (by rows):
+     *       const vec3 *Colors;
+     * RETURNS: None.
+     */
+    VOID AddBlock( INT X0, INT Y0, INT BW, INT BH, const vec3 *Colors )
+    {
+      INT Stride = BW;
+
+      if (!Clip(X0, Y0, BW, BH, Colors, Stride))
+        return;
+      for (INT y = 0; y < BH; y++)
+        for (INT x = 0; x < BW; x++)
+        {
+          FLT *C = Texel(X0 + x, Y0 + y);
+          const vec3 &Src = Colors[y * Stride + x];
+
+          C[0] += static_cast<FLT>(Src[0]);
+          C[1] += static_cast<FLT>(Src[1]);
+          C[2] += static_cast<FLT>(Src[2]);
+          C[3] += 1;
+        }
+    } /* End of 'AddBlock' function */
+
+    /* Build present buffer pixels of block function.
+     * Float colors are scaled, clamped and quantized by runs of tile
+     * row pixels, so the loop is compiled to vector instructions.
+     * ARGUMENTS:
+     *   - block corner and size:
+     *       INT X0, Y0, BW, BH;
+     *   - plane to linear colors factor (for accumulated sums):
+     *       FLT BlockScale;
+     * RETURNS: None.
+     */
+    VOID Present( INT X0, INT Y0, INT BW, INT BH, FLT BlockScale = 1 )
+    {
+      INT X1 = min(X0 + BW, W), Y1 = min(Y0 + BH, H);
+      FLT Mul = BlockScale * 255;
+
+      X0 = max(X0, 0);
+      Y0 = max(Y0, 0);
+      for (INT y = Y0; y < Y1; y++)
+        for (INT x = X0; x < X1; )
+        {
+          INT Run = min(TileSide - x % TileSide, X1 - x);
+          const FLT *C = Texel(x, y);
+          DWORD *D = &Pixels[y * W + x];
+
+          for (INT i = 0; i < Run; i++)
+          {
+            FLT
+              b = C[i * 4 + 0] * Mul,
+              g = C[i * 4 + 1] * Mul,
+              r = C[i * 4 + 2] * Mul;
+
+            b = b < 0 ? 0 : b > 255 ? 255 : b;
+            g = g < 0 ? 0 : g > 255 ? 255 : g;
+            r = r < 0 ? 0 : r > 255 ? 255 : r;
+            D[i] = static_cast<DWORD>(b) | static_cast<DWORD>(g) << 8 | static_cast<DWORD>(r) << 16;
+          }
+          x += Run;
+        }
+    } /* End of 'Present' function */
+
+    /* Build whole present buffer function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Present( VOID )
+    {
+      Present(0, 0, W, H, Scale);
+    } /* End of 'Present' function */
+
+    /* Set plane to linear colors factor function.
+     * ARGUMENTS:
+     *   - new factor (1 / passes count for accumulated sums):
+     *       FLT NewScale;
+     * RETURNS: None.
+     */
+    VOID SetScale( FLT NewScale )
+    {
+      Scale = NewScale;
+    } /* End of 'SetScale' function */
+
+    /* Obtain present buffer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const DWORD *) W * H pixels (0x00RRGGBB, rows from top).
+     */
+    const DWORD * GetPresent( VOID ) const
+    {
+      return Pixels.data();
+    } /* End of 'GetPresent' function */
+
+#ifdef _WIN32
     /* Draw frame buffer function.
      * ARGUMENTS:
      *   - device context:
@@ -137,7 +366,7 @@ namespace gort
       bih.biYPelsPerMeter = 30;
 
       SetStretchBltMode(hDC, COLORONCOLOR);
-      StretchDIBits(hDC, X, Y, W, H, 0, 0, W, H, Pixels, (BITMAPINFO *)&bih, DIB_RGB_COLORS, SRCCOPY);
+      StretchDIBits(hDC, X, Y, W, H, 0, 0, W, H, Pixels.data(), (BITMAPINFO *)&bih, DIB_RGB_COLORS, SRCCOPY);
     } /* End of 'Draw' function */
 
     /* Save frame buffer to tga function.
@@ -191,7 +420,7 @@ namespace gort
             std::to_string(st.wMinute) + "_" +
             std::to_string(st.wSecond) + "_" +
             std::to_string(st.wMilliseconds) + "_" +
-            std::to_string(rand() % 3000);
+            std::to_string(rnd::Thread().Next() % 3000);
 
       std::fstream f(path + "/" + FileName + ".tga", std::fstream::out | std::fstream::binary);
       if (!f.is_open())
@@ -202,11 +431,152 @@ namespace gort
       //f.write((CHAR *)"Dan Gorlyakov, CGSG 2021", sizeof(WORD));
       //f.write((CHAR *), sizeof(WORD));
       f.write("Copyright (C) 2021 Computer Graphics Support Group of 30 Phys-Math Lyceum", fh.IDLength);
-      f.write((CHAR *)Pixels, W * H * 4);
+      f.write((CHAR *)Pixels.data(), W * H * 4);
       f.write((CHAR *)&ff, sizeof(ff));
 
       return TRUE;
     } /* End of 'SaveTGA' function */
+#endif /* _WIN32 */
+
+    /* Save frame buffer to tga file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if image saved, FALSE if not.
+     */
+    BOOL SaveTGA( const std::string &FileName ) const
+    {
+      std::vector<CHAR> Buf; // must outlive the stream
+      std::ofstream f;
+      BYTE Head[18] = {0};
+
+      if (!OpenOutput(f, Buf, FileName))
+        return FALSE;
+
+      Head[2] = 2;                   // uncompressed true color
+      Head[12] = W & 0xFF, Head[13] = (W >> 8) & 0xFF;
+      Head[14] = H & 0xFF, Head[15] = (H >> 8) & 0xFF;
+      Head[16] = 32;                 // bits per pixel
+      Head[17] = 32;                 // top-left origin
+      f.write((CHAR *)Head, sizeof(Head));
+      f.write((CHAR *)Pixels.data(), W * H * 4);
+      f.close();
+      return !f.fail();
+    } /* End of 'SaveTGA' function */
+
+    /* Save frame buffer to binary ppm file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if image saved, FALSE if not.
+     */
+    BOOL SavePPM( const std::string &FileName ) const
+    {
+      std::vector<CHAR> Buf; // must outlive the stream
+      std::ofstream f;
+      std::vector<BYTE> Row(W * 3);
+
+      if (!OpenOutput(f, Buf, FileName))
+        return FALSE;
+
+      f << "P6\n" << W << " " << H << "\n255\n";
+      for (INT y = 0; y < H; y++)
+      {
+        // pixels are stored as 0x00RRGGBB (like Windows DIB)
+        for (INT x = 0; x < W; x++)
+        {
+          DWORD c = Pixels[y * W + x];
+
+          Row[x * 3 + 0] = (c >> 16) & 0xFF;
+          Row[x * 3 + 1] = (c >> 8) & 0xFF;
+          Row[x * 3 + 2] = c & 0xFF;
+        }
+        f.write((CHAR *)Row.data(), Row.size());
+      }
+      f.close();
+      return !f.fail();
+    } /* End of 'SavePPM' function */
+
+    /* Save frame linear colors to portable float map file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if image saved, FALSE if not.
+     */
+    BOOL SavePFM( const std::string &FileName ) const
+    {
+      std::vector<CHAR> Buf; // must outlive the stream
+      std::ofstream f;
+      std::vector<FLT> Row(W * 3);
+
+      if (!OpenOutput(f, Buf, FileName))
+        return FALSE;
+
+      // negative scale - little endian data, rows go from bottom to top
+      f << "PF\n" << W << " " << H << "\n-1.0\n";
+      for (INT y = H - 1; y >= 0; y--)
+      {
+        for (INT x = 0; x < W; x++)
+        {
+          const FLT *C = Texel(x, y);
+
+          Row[x * 3 + 0] = C[2] * Scale;
+          Row[x * 3 + 1] = C[1] * Scale;
+          Row[x * 3 + 2] = C[0] * Scale;
+        }
+        f.write((CHAR *)Row.data(), Row.size() * sizeof(FLT));
+      }
+      f.close();
+      return !f.fail();
+    } /* End of 'SavePFM' function */
+
+    /* Load frame linear colors from portable float map file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if image loaded, FALSE if not.
+     */
+    BOOL LoadPFM( const std::string &FileName )
+    {
+      std::ifstream f(FileName, std::ifstream::binary);
+      std::string Magic;
+      INT NewW, NewH;
+      DBL Scale;
+
+      if (!(f >> Magic >> NewW >> NewH >> Scale) || Magic != "PF" || NewW <= 0 || NewH <= 0 || Scale >= 0)
+        return FALSE;
+      f.get();
+
+      std::vector<FLT> Row(NewW * 3);
+
+      Resize(NewW, NewH);
+      for (INT y = H - 1; y >= 0; y--)
+      {
+        if (!f.read((CHAR *)Row.data(), Row.size() * sizeof(FLT)))
+          return FALSE;
+        for (INT x = 0; x < W; x++)
+          PutPixel(x, y, vec3(Row[x * 3 + 2], Row[x * 3 + 1], Row[x * 3 + 0]));
+      }
+      return TRUE;
+    } /* End of 'LoadPFM' function */
+
+    /* Obtain pixel linear color function.
+     * ARGUMENTS:
+     *   - pixel coords:
+     *       INT X, Y;
+     * RETURNS:
+     *   (vec3) pixel color.
+     */
+    vec3 GetPixel( INT X, INT Y ) const
+    {
+      const FLT *C = Texel(X, Y);
+
+      return vec3(C[0] * Scale, C[1] * Scale, C[2] * Scale);
+    } /* End of 'GetPixel' function */
   }; /* End of 'frame' class */
 } /* end of 'gort' namespace */
 
@@ -0,0 +1,265 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : area.h
+ * PURPOSE     : Ray tracing project.
+ *               Area (sphere and rectangle) lights handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __area_h_
+#define __area_h_
+
+#include "../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Area light base class.
+   * Every sample of light is attenuated as a point light of the whole
+   * light color, shading averages samples and so gives soft shadows. */
+  class area : public light
+  {
+  protected:
+    vec3 Color;       // Light color
+    INT Samples = 16; // Maximal shadow samples per lit point
+
+    /* Obtain sample attenuation function.
+     * ARGUMENTS:
+     *   - lit point:
+     *       const vec3 &P;
+     *   - light sample point:
+     *       const vec3 &S;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS:
+     *   (REAL) attenuation.
+     */
+    REAL Attenuate( const vec3 &P, const vec3 &S, light_info *L )
+    {
+      L->Color = Color;
+      L->Dist = !(S - P);
+      L->L = (S - P) / L->Dist;
+      return min(1 / (Cc + Cl * L->Dist + Cq * L->Dist * L->Dist), 1);
+    } /* End of 'Attenuate' function */
+
+  public:
+    /* Obtain maximal shadow samples per lit point function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) samples count.
+     */
+    INT GetSamples( VOID ) override
+    {
+      return Samples;
+    } /* End of 'GetSamples' function */
+
+    /* Set maximal shadow samples per lit point function.
+     * Samples are taken by stratified grid, so count is rounded up
+     * to a power of 4 by shading.
+     * ARGUMENTS:
+     *   - new samples count (at least 2):
+     *      INT NewSamples;
+     * RETURNS: None.
+     */
+    VOID SetSamples( INT NewSamples )
+    {
+      Samples = max(NewSamples, 2);
+    } /* End of 'SetSamples' function */
+  }; /* End of 'area' class */
+
+  /* Sphere light class.
+   * Samples are taken on the sphere disk seen from the lit point. */
+  class sphere_light : public area
+  {
+  private:
+    vec3 C;  // Sphere center
+    REAL R;  // Sphere radius
+
+    /* Shadow light function (sphere center sample).
+     * ARGUMENTS:
+     *   - intersection point:
+     *       const vec3 &P;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS: attenuation.
+     */
+    REAL Shadow( const vec3 &P, light_info *L ) override
+    {
+      return Attenuate(P, C, L);
+    } /* End of 'Shadow' function */
+
+    /* Sample light point function.
+     * ARGUMENTS:
+     *   - lit point:
+     *       const vec3 &P;
+     *   - sample coordinates in [0, 1) (radius and angle on disk):
+     *       REAL U, V;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS:
+     *   (REAL) attenuation of light sample.
+     */
+    REAL Sample( const vec3 &P, REAL U, REAL V, light_info *L ) override
+    {
+      vec3 W = C - P;
+      REAL d = !W;
+
+      // point inside light sees its center
+      if (d <= R)
+        return Attenuate(P, C, L);
+      W = W / d;
+
+      // disk basis perpendicular to the direction to center
+      vec3
+        A = (fabs(W[0]) > 0.5 ? vec3(0, 1, 0) : vec3(1, 0, 0)) % W,
+        B;
+
+      A = A.Normalizing();
+      B = W % A;
+
+      REAL
+        r = R * sqrt(U),
+        phi = 2 * mth::PI * V;
+
+      return Attenuate(P, C + (A * cos(phi) + B * sin(phi)) * r, L);
+    } /* End of 'Sample' function */
+
+    /* Obtain light contribution bound function.
+     * ARGUMENTS:
+     *   - bound pointer:
+     *      light_bound *B;
+     * RETURNS:
+     *   (BOOL) TRUE (sphere light is local).
+     */
+    BOOL GetBound( light_bound *B ) override
+    {
+      B->BB = aabb(C - vec3(R), C + vec3(R));
+      B->Cc = Cc;
+      B->Cl = Cl;
+      B->Cq = Cq;
+      B->Power = max(Color[0], max(Color[1], Color[2]));
+      return TRUE;
+    } /* End of 'GetBound' function */
+
+  public:
+    /* Light class constructor
+     * ARGUMENTS:
+     *   - sphere center and radius:
+     *     const vec3 &NewC; REAL NewR;
+     *   - light color:
+     *     const vec3 &NewColor;
+     *   - attenuation coefficients (constant, linear, quadratic):
+     *     REAL NewCc, NewCl, NewCq;
+     *   - maximal shadow samples per lit point:
+     *     INT NewSamples;
+     */
+    sphere_light( const vec3 &NewC, REAL NewR, const vec3 &NewColor, REAL NewCc, REAL NewCl, REAL NewCq,
+                  INT NewSamples = 16 )
+      : C(NewC), R(fabs(NewR))
+    {
+      Color = NewColor;
+      Cc = NewCc;
+      Cl = NewCl;
+      Cq = NewCq;
+      SetSamples(NewSamples);
+    } /* End of 'sphere_light' function */
+  }; /* End of 'sphere_light' class */
+
+  /* Rectangle light class.
+   * Light is emitted to the side of 'E1 % E2' normal only, samples
+   * are weighted by emission angle cosine. */
+  class rect_light : public area
+  {
+  private:
+    vec3 O;       // Rectangle corner
+    vec3 E1, E2;  // Rectangle edges from corner
+    vec3 N;       // Emission side normal
+
+    /* Shadow light function (rectangle center sample).
+     * ARGUMENTS:
+     *   - intersection point:
+     *       const vec3 &P;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS: attenuation.
+     */
+    REAL Shadow( const vec3 &P, light_info *L ) override
+    {
+      return Sample(P, 0.5, 0.5, L);
+    } /* End of 'Shadow' function */
+
+    /* Sample light point function.
+     * ARGUMENTS:
+     *   - lit point:
+     *       const vec3 &P;
+     *   - sample coordinates in [0, 1) (along edges):
+     *       REAL U, V;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS:
+     *   (REAL) attenuation of light sample (0 behind light).
+     */
+    REAL Sample( const vec3 &P, REAL U, REAL V, light_info *L ) override
+    {
+      REAL att = Attenuate(P, O + E1 * U + E2 * V, L), c = -(L->L & N);
+
+      return c > 0 ? att * c : 0;
+    } /* End of 'Sample' function */
+
+    /* Obtain light contribution bound function.
+     * ARGUMENTS:
+     *   - bound pointer:
+     *      light_bound *B;
+     * RETURNS:
+     *   (BOOL) TRUE (rectangle light is local).
+     */
+    BOOL GetBound( light_bound *B ) override
+    {
+      B->BB = aabb();
+      B->BB.Grow(O);
+      B->BB.Grow(O + E1);
+      B->BB.Grow(O + E2);
+      B->BB.Grow(O + E1 + E2);
+      B->Cc = Cc;
+      B->Cl = Cl;
+      B->Cq = Cq;
+      B->Power = max(Color[0], max(Color[1], Color[2]));
+      return TRUE;
+    } /* End of 'GetBound' function */
+
+  public:
+    /* Light class constructor
+     * ARGUMENTS:
+     *   - rectangle corner and edges from it:
+     *     const vec3 &NewO, &NewE1, &NewE2;
+     *   - light color:
+     *     const vec3 &NewColor;
+     *   - attenuation coefficients (constant, linear, quadratic):
+     *     REAL NewCc, NewCl, NewCq;
+     *   - maximal shadow samples per lit point:
+     *     INT NewSamples;
+     */
+    rect_light( const vec3 &NewO, const vec3 &NewE1, const vec3 &NewE2, const vec3 &NewColor,
+                REAL NewCc, REAL NewCl, REAL NewCq, INT NewSamples = 16 )
+      : O(NewO), E1(NewE1), E2(NewE2), N((NewE1 % NewE2).Normalizing())
+    {
+      Color = NewColor;
+      Cc = NewCc;
+      Cl = NewCl;
+      Cq = NewCq;
+      SetSamples(NewSamples);
+    } /* End of 'rect_light' function */
+  }; /* End of 'rect_light' class */
+} /* end of 'gort' namespace */
+
+#endif /* __area_h_ */
+
+/* END OF 'area.h' FILE */
@@ -1,22 +1,69 @@
 /*************************************************************
  * Copyright (C) 2021
- *    Computer Graphics Suppodirection Group of 30 Phys-Math Lyceum
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
  *************************************************************/
  
 /* FILE NAME   : direction.h
  * PURPOSE     : Ray tracing project.
  *               Direction light handle module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 03.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
- * No padirection of this file may be changed without agreement of
- * Computer Graphics Suppodirection Group of 30 Phys-Math Lyceum
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
  */
 
 #ifndef __direction_h_
 #define __direction_h_
 
+#include "../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Direction (infinitely far) light class.
+   * Light has no attenuation and no position, so it is evaluated at
+   * every point: points facing away from it are skipped by shading
+   * before the shadow ray. */
+  class direction : public light
+  {
+  private:
+    vec3 Dir;    // Light direction (normalized, from light)
+    vec3 Color;  // Light color
+
+    /* Shadow light function.
+     * ARGUMENTS:
+     *   - intersection point:
+     *       const vec3 &P;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS: attenuation.
+     */
+    REAL Shadow( const vec3 &P, light_info *L ) override
+    {
+      L->Color = Color;
+      L->Dist = HUGE_VAL;
+      L->L = -Dir;
+      return 1;
+    } /* End of 'Shadow' function */
+
+  public:
+    /* Light class constructor
+     * ARGUMENTS:
+     *   - light direction:
+     *     const vec3 &NewDir;
+     *   - light color:
+     *     const vec3 &NewColor;
+     */
+    direction( const vec3 &NewDir, const vec3 &NewColor ) : Dir(NewDir.Normalizing()), Color(NewColor)
+    {
+      Cc = 1;
+      Cl = Cq = 0;
+    } /* End of 'direction' function */
+  }; /* End of 'direction' class */
+} /* end of 'gort' namespace */
+
 #endif /* __direction_h_ */
 
-/* END OF 'direction.h' FILE */
\ No newline at end of file
+/* END OF 'direction.h' FILE */
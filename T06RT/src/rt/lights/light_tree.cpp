@@ -0,0 +1,64 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : light_tree.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Lights hierarchy functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "light_tree.h"
+
+/* Build hierarchy function.
+ * ARGUMENTS:
+ *   - light bounds:
+ *      const std::vector<light_bound> &Bounds;
+ * RETURNS: None.
+ */
+VOID gort::light_tree::Build( const std::vector<light_bound> &Bounds )
+{
+  std::vector<aabb> Boxes;
+
+  Clear();
+  for (auto &B : Bounds)
+    Boxes.push_back(B.BB);
+  Tree.Build(Boxes);
+
+  // Lights in leaves order
+  Index = Tree.Renumber([]( INT Prim ) { return 0; });
+  for (INT i : Index)
+    Lights.push_back(Bounds[i]);
+
+  // Children follow their parent in nodes array, so bounds are merged bottom up
+  const std::vector<bvh::node> &TN = Tree.GetNodes();
+
+  Nodes.resize(TN.size());
+  for (INT i = static_cast<INT>(TN.size()) - 1; i >= 0; i--)
+  {
+    const bvh::node &N = TN[i];
+    light_bound &B = Nodes[i];
+    INT First = N.Count > 0 ? N.Offset : 0, Count = N.Count > 0 ? N.Count : 2;
+
+    B.BB = N.BB;
+    B.Cc = B.Cl = B.Cq = HUGE_VAL;
+    B.Power = 0;
+    for (INT k = 0; k < Count; k++)
+    {
+      const light_bound &L = N.Count > 0 ? Lights[First + k] : Nodes[k == 0 ? i + 1 : N.Offset];
+
+      B.Cc = min(B.Cc, L.Cc);
+      B.Cl = min(B.Cl, L.Cl);
+      B.Cq = min(B.Cq, L.Cq);
+      B.Power = max(B.Power, L.Power);
+    }
+  }
+} /* End of 'Build' function */
+
+/* END OF 'light_tree.cpp' FILE */
@@ -0,0 +1,176 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : light_tree.h
+ * PURPOSE     : Ray tracing project.
+ *               Lights hierarchy handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __light_tree_h_
+#define __light_tree_h_
+
+#include <vector>
+
+#include "../../def.h"
+#include "../bvh/bvh.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Light contribution bound class.
+   * Attenuation coefficients are expected to be non negative, so the
+   * smallest ones of a group give the largest contribution. Cone is
+   * used by single lights only: its apex is 'BB.Min' (lights with cones
+   * are points), groups keep the whole sphere. */
+  class light_bound
+  {
+  public:
+    aabb BB;                // Light positions box
+    REAL Cc, Cl, Cq;        // Attenuation coefficients (minimal for group)
+    REAL Power;             // Maximal color component (maximal for group)
+    vec3 Axis = vec3(0);    // Lit cone axis
+    REAL CosAngle = -1;     // Lit cone half angle cosine (-1 for whole sphere)
+
+    /* Is contribution not less than cutoff at point function.
+     * Contribution 'Power * min(1 / (Cc + Cl * d + Cq * d^2), 1)' at
+     * distance 'd' to the box is compared without division, points
+     * outside the cone get no light at all.
+     * ARGUMENTS:
+     *   - lit point:
+     *      const vec3 &P;
+     *   - contribution cutoff:
+     *      REAL Cutoff;
+     * RETURNS:
+     *   (BOOL) TRUE if light may contribute to point.
+     */
+    BOOL IsVisible( const vec3 &P, REAL Cutoff ) const
+    {
+      REAL Dist = BB.Dist(P);
+
+      return Power >= Cutoff * max(Cc + Cl * Dist + Cq * Dist * Dist, 1) &&
+        ((P - BB.Min) & Axis) >= CosAngle * Dist;
+    } /* End of 'IsVisible' function */
+  }; /* End of 'light_bound' class */
+
+  /* Lights hierarchy class.
+   * Lights are grouped by the shapes hierarchy builder, every node keeps
+   * contribution bound of its lights, so groups too weak for a point
+   * are skipped without looking at their lights. */
+  class light_tree
+  {
+  private:
+    bvh Tree;                          // Lights hierarchy
+    std::vector<light_bound> Lights;   // Light bounds (in leaves order)
+    std::vector<INT> Index;            // Build index of every light (in leaves order)
+    std::vector<light_bound> Nodes;    // Node bounds (by tree node index)
+
+  public:
+    /* Build hierarchy function.
+     * ARGUMENTS:
+     *   - light bounds:
+     *      const std::vector<light_bound> &Bounds;
+     * RETURNS: None.
+     */
+    VOID Build( const std::vector<light_bound> &Bounds );
+
+    /* Clear hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID )
+    {
+      Tree.Clear();
+      Lights.clear();
+      Index.clear();
+      Nodes.clear();
+    } /* End of 'Clear' function */
+
+    /* Visit lights contributing to point function.
+     * ARGUMENTS:
+     *   - lit point:
+     *      const vec3 &P;
+     *   - contribution cutoff (lights with smaller bound are skipped):
+     *      REAL Cutoff;
+     *   - light functor (VOID Func( INT Light ), index in build bounds):
+     *      light_func Func;
+     * RETURNS: None.
+     */
+    template<typename light_func>
+      VOID Select( const vec3 &P, REAL Cutoff, light_func Func ) const
+      {
+        if (Nodes.empty())
+          return;
+        // no culling - all lights in build order
+        if (Cutoff <= 0)
+        {
+          for (INT i = 0; i < static_cast<INT>(Index.size()); i++)
+            Func(i);
+          return;
+        }
+
+        const std::vector<bvh::node> &TN = Tree.GetNodes();
+        INT Stack[bvh::MaxDepth + 1], Sp = 0, Cur = 0;
+
+        while (TRUE)
+        {
+          const bvh::node &N = TN[Cur];
+
+          if (Nodes[Cur].IsVisible(P, Cutoff))
+          {
+            if (N.Count > 0)
+            {
+              UINT Mask = 0;
+
+              // whole leaf is tested first, then lit lights are shaded
+              for (INT i = 0; i < N.Count; i++)
+                Mask |= Lights[N.Offset + i].IsVisible(P, Cutoff) << i;
+              for (INT i = 0; i < N.Count; i++)
+                if (Mask & (1u << i))
+                  Func(Index[N.Offset + i]);
+            }
+            else
+            {
+              Stack[Sp++] = N.Offset;
+              Cur = Cur + 1;
+              continue;
+            }
+          }
+          if (Sp == 0)
+            break;
+          Cur = Stack[--Sp];
+        }
+      } /* End of 'Select' function */
+
+    /* Obtain lights count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) lights in hierarchy.
+     */
+    INT GetCount( VOID ) const
+    {
+      return static_cast<INT>(Lights.size());
+    } /* End of 'GetCount' function */
+
+    /* Obtain nodes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) nodes count.
+     */
+    INT GetNodeCount( VOID ) const
+    {
+      return static_cast<INT>(Nodes.size());
+    } /* End of 'GetNodeCount' function */
+  }; /* End of 'light_tree' class */
+} /* end of 'gort' namespace */
+
+#endif /* __light_tree_h_ */
+
+/* END OF 'light_tree.h' FILE */
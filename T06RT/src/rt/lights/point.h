@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Point light handle module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 03.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No papoint of this file may be changed without agreement of
@@ -28,7 +28,7 @@ namespace gort
   private:
     vec3 Pos; // Point light position
     vec3 Color; // Light color
-    DBL R1, R2; // Decay radius
+    REAL R1, R2; // Decay radius
 
     /* Shadow light function.
      * ARGUMENTS:
@@ -38,7 +38,7 @@ namespace gort
      *       light_info *L;
      * RETURNS: attenuation.
      */
-    DBL Shadow( const vec3 &P, light_info *L ) override
+    REAL Shadow( const vec3 &P, light_info *L ) override
     {
       L->Color = Color;
       L->Dist = !(Pos - P);
@@ -47,6 +47,23 @@ namespace gort
       return min(1 / (Cc + Cl * L->Dist + Cq * L->Dist * L->Dist), 1);
     } /* End of 'Shadow' function */
 
+    /* Obtain light contribution bound function.
+     * ARGUMENTS:
+     *   - bound pointer:
+     *      light_bound *B;
+     * RETURNS:
+     *   (BOOL) TRUE (point light is local).
+     */
+    BOOL GetBound( light_bound *B ) override
+    {
+      B->BB = aabb(Pos, Pos);
+      B->Cc = Cc;
+      B->Cl = Cl;
+      B->Cq = Cq;
+      B->Power = max(Color[0], max(Color[1], Color[2]));
+      return TRUE;
+    } /* End of 'GetBound' function */
+
   public:
 
     /* Default constructor */
@@ -61,11 +78,11 @@ namespace gort
      *   - light color:
      *     const vec3 &NewColor;
      *   - light decay radius:
-     *     const DBL &NewR1, &NewR2;
+     *     const REAL &NewR1, &NewR2;
      *   - ???:
-     *     const DBL &Cc, &Cl, &Cq;
+     *     const REAL &Cc, &Cl, &Cq;
      */
-    point( const vec3 &NewPos, const vec3 &NewColor, const DBL &NewR1, const DBL &NewR2, const DBL &NewCc, const DBL &NewCl, const DBL &NewCq )
+    point( const vec3 &NewPos, const vec3 &NewColor, const REAL &NewR1, const REAL &NewR2, const REAL &NewCc, const REAL &NewCl, const REAL &NewCq )
       : Pos(NewPos), Color(NewColor), R1(NewR1), R2(NewR2)
     {
       Cc = NewCc;
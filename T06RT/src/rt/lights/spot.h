@@ -1,22 +1,104 @@
 /*************************************************************
  * Copyright (C) 2021
- *    Computer Graphics Suppospot Group of 30 Phys-Math Lyceum
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
  *************************************************************/
  
 /* FILE NAME   : spot.h
  * PURPOSE     : Ray tracing project.
  *               Spot light handle module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 03.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
- * No paspot of this file may be changed without agreement of
- * Computer Graphics Suppospot Group of 30 Phys-Math Lyceum
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
  */
 
 #ifndef __spot_h_
 #define __spot_h_
 
+#include "../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Spot light class */
+  class spot : public light
+  {
+  private:
+    vec3 Pos;    // Spot light position
+    vec3 Dir;    // Spot direction (normalized)
+    vec3 Color;  // Light color
+    REAL CosInner, CosOuter;  // Full light and no light cone half angles cosines
+
+    /* Shadow light function.
+     * ARGUMENTS:
+     *   - intersection point:
+     *       const vec3 &P;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS: attenuation (0 outside the outer cone).
+     */
+    REAL Shadow( const vec3 &P, light_info *L ) override
+    {
+      L->Color = Color;
+      L->Dist = !(Pos - P);
+      L->L = (Pos - P) / L->Dist;
+
+      REAL c = -(L->L & Dir);
+
+      if (c <= CosOuter)
+        return 0;
+
+      // smooth falloff between outer and inner cones
+      REAL s = c >= CosInner ? 1 : (c - CosOuter) / (CosInner - CosOuter);
+
+      return min(1 / (Cc + Cl * L->Dist + Cq * L->Dist * L->Dist), 1) * s * s * (3 - 2 * s);
+    } /* End of 'Shadow' function */
+
+    /* Obtain light contribution bound function.
+     * ARGUMENTS:
+     *   - bound pointer:
+     *      light_bound *B;
+     * RETURNS:
+     *   (BOOL) TRUE (spot light is local).
+     */
+    BOOL GetBound( light_bound *B ) override
+    {
+      B->BB = aabb(Pos, Pos);
+      B->Cc = Cc;
+      B->Cl = Cl;
+      B->Cq = Cq;
+      B->Power = max(Color[0], max(Color[1], Color[2]));
+      B->Axis = Dir;
+      B->CosAngle = CosOuter;
+      return TRUE;
+    } /* End of 'GetBound' function */
+
+  public:
+    /* Light class constructor
+     * ARGUMENTS:
+     *   - light position and direction:
+     *     const vec3 &NewPos, &NewDir;
+     *   - light color:
+     *     const vec3 &NewColor;
+     *   - full light and no light cone half angles in degrees:
+     *     REAL InnerAngle, OuterAngle;
+     *   - attenuation coefficients (constant, linear, quadratic):
+     *     REAL NewCc, NewCl, NewCq;
+     */
+    spot( const vec3 &NewPos, const vec3 &NewDir, const vec3 &NewColor, REAL InnerAngle, REAL OuterAngle,
+          REAL NewCc, REAL NewCl, REAL NewCq )
+      : Pos(NewPos), Dir(NewDir.Normalizing()), Color(NewColor),
+        CosInner(cos(mth::Degree2Radian(min(InnerAngle, OuterAngle)))), CosOuter(cos(mth::Degree2Radian(OuterAngle)))
+    {
+      Cc = NewCc;
+      Cl = NewCl;
+      Cq = NewCq;
+    } /* End of 'spot' function */
+  }; /* End of 'spot' class */
+} /* end of 'gort' namespace */
+
 #endif /* __spot_h_ */
 
-/* END OF 'spot.h' FILE */
\ No newline at end of file
+/* END OF 'spot.h' FILE */
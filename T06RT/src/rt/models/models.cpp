@@ -0,0 +1,568 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : models.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Model files (OBJ, G3DM) import implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "models.h"
+
+/* OBJ faces group (one per material) class */
+class obj_group
+{
+public:
+  gort::surface Mtl;        // Group material
+  gort::REAL Ni = 1;        // Group refraction coefficient
+  std::vector<INT> Corners; // Triangle corners as (position, texture, normal) index triples
+}; /* End of 'obj_group' class */
+
+/* OBJ material with refraction coefficient class */
+class obj_mtl
+{
+public:
+  gort::surface Mtl;  // Surface coefficients
+  gort::REAL Ni = 1;  // Refraction coefficient
+  INT Illum = 2;      // Illumination model
+}; /* End of 'obj_mtl' class */
+
+/* Skip spaces function.
+ * ARGUMENTS:
+ *   - string pointer:
+ *      const CHAR *S;
+ * RETURNS:
+ *   (const CHAR *) first non space character.
+ */
+static const CHAR * SkipSpaces( const CHAR *S )
+{
+  while (*S == ' ' || *S == '\t')
+    S++;
+  return S;
+} /* End of 'SkipSpaces' function */
+
+/* Read three numbers function.
+ * ARGUMENTS:
+ *   - string pointer:
+ *      const CHAR *S;
+ * RETURNS:
+ *   (vec3) read vector (missing components are 0).
+ */
+static gort::vec3 ReadVec3( const CHAR *S )
+{
+  CHAR *End;
+  DBL x = strtod(S, &End), y = strtod(End, &End), z = strtod(End, &End);
+
+  return gort::vec3(x, y, z);
+} /* End of 'ReadVec3' function */
+
+/* Read material color function.
+ * Files store RGB, renderer colors keep blue in component 0 (as 'toRGB'
+ * and frame files do). Single number is grey (as MTL format defines).
+ * ARGUMENTS:
+ *   - string pointer:
+ *      const CHAR *S;
+ * RETURNS:
+ *   (vec3) read color.
+ */
+static gort::vec3 ReadColor( const CHAR *S )
+{
+  CHAR *End;
+  DBL r = strtod(S, &End), g, b;
+
+  S = End;
+  g = strtod(S, &End);
+  if (End == S)
+    return gort::vec3(r);
+  b = strtod(End, &End);
+  return gort::vec3(b, g, r);
+} /* End of 'ReadColor' function */
+
+/* Load OBJ materials library function.
+ * ARGUMENTS:
+ *   - scene to own diffuse maps:
+ *      scene &Scene;
+ *   - library file name:
+ *      const std::string &FileName;
+ *   - materials by name map:
+ *      std::map<std::string, obj_mtl> &Mtls;
+ * RETURNS: None.
+ */
+static VOID LoadMTL( gort::scene &Scene, const std::string &FileName, std::map<std::string, obj_mtl> &Mtls )
+{
+  std::ifstream f(FileName);
+  std::string Dir = FileName.substr(0, FileName.find_last_of("/\\") + 1);
+  std::string Line;
+  obj_mtl *Cur = nullptr;
+
+  while (std::getline(f, Line))
+  {
+    const CHAR *S = SkipSpaces(Line.c_str());
+    std::string Key;
+
+    while (*S != 0 && *S != ' ' && *S != '\t' && *S != '\r')
+      Key += *S++;
+    S = SkipSpaces(S);
+
+    if (Key == "newmtl")
+    {
+      std::string Name(S);
+
+      while (!Name.empty() && (Name.back() == '\r' || Name.back() == ' '))
+        Name.pop_back();
+      Cur = &Mtls[Name];
+      Cur->Mtl = gort::surface(gort::vec3(0.1), gort::vec3(0.8), gort::vec3(0.2), 16, 0, 0);
+    }
+    else if (Cur == nullptr)
+      continue;
+    else if (Key == "Ka")
+      Cur->Mtl.Ka = ReadColor(S);
+    else if (Key == "Kd")
+      Cur->Mtl.Kd = ReadColor(S);
+    else if (Key == "Ks")
+      Cur->Mtl.Ks = ReadColor(S);
+    else if (Key == "Ns")
+      Cur->Mtl.Ph = static_cast<gort::REAL>(atof(S));
+    else if (Key == "d")
+      Cur->Mtl.Kt = static_cast<gort::REAL>(1 - atof(S));
+    else if (Key == "Tr")
+      Cur->Mtl.Kt = static_cast<gort::REAL>(atof(S));
+    else if (Key == "Ni")
+      Cur->Ni = static_cast<gort::REAL>(atof(S));
+    else if (Key == "illum")
+      Cur->Illum = atoi(S);
+    else if (Key == "map_Kd")
+    {
+      // map options are skipped, file name is the last word
+      std::string Name(S);
+
+      while (!Name.empty() && (Name.back() == '\r' || Name.back() == ' '))
+        Name.pop_back();
+      Name = Name.substr(Name.find_last_of(" \t") + 1);
+
+      gort::texture *Tex = new gort::texture;
+
+      if (Tex->Load(Dir + Name))
+        Scene << Tex, Cur->Mtl.Map = Tex;
+      else
+        delete Tex;
+    }
+  }
+
+  // illumination models 3, 5, 7 - ray traced reflection
+  for (auto &M : Mtls)
+    if (M.second.Illum == 3 || M.second.Illum == 5 || M.second.Illum == 7)
+      M.second.Mtl.Kr = max(M.second.Mtl.Ks[0], max(M.second.Mtl.Ks[1], M.second.Mtl.Ks[2]));
+} /* End of 'LoadMTL' function */
+
+/* Loaded model meshes list class.
+ * Meshes are kept here until the whole model is read, so a broken file
+ * adds nothing to scene. */
+class mesh_list
+{
+private:
+  std::vector<gort::mesh *> Meshes; // Created meshes
+  gort::aabb Box;                   // Meshes bounding box
+
+public:
+  /* Mesh list destructor (deletes meshes not added to scene) */
+  ~mesh_list( VOID )
+  {
+    for (auto M : Meshes)
+      delete M;
+  } /* End of '~mesh_list' function */
+
+  /* Add mesh function.
+   * ARGUMENTS:
+   *   - mesh data:
+   *      std::vector<vec3> &&V, std::vector<INT> &&Ind, std::vector<vec3> &&N, std::vector<vec2> &&T;
+   *   - mesh material and refraction coefficient:
+   *      const surface &Mtl; REAL Ni;
+   * RETURNS: None.
+   */
+  VOID Add( std::vector<gort::vec3> &&V, std::vector<INT> &&Ind, std::vector<gort::vec3> &&N,
+            std::vector<gort::vec2> &&T, const gort::surface &Mtl, gort::REAL Ni )
+  {
+    if (Ind.empty())
+      return;
+    for (auto &P : V)
+      Box.Grow(P);
+
+    gort::mesh *M = new gort::mesh(std::move(V), std::move(Ind), Mtl, std::move(N), std::move(T));
+
+    M->Media = gort::envi(Ni, 0);
+    Meshes.push_back(M);
+  } /* End of 'Add' function */
+
+  /* Move meshes to scene function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - bounding box pointer (extended, may be nullptr):
+   *      aabb *BB;
+   * RETURNS: None.
+   */
+  VOID Commit( gort::scene &Scene, gort::aabb *BB )
+  {
+    for (auto M : Meshes)
+      Scene << M;
+    Meshes.clear();
+    if (BB != nullptr)
+      BB->Grow(Box);
+  } /* End of 'Commit' function */
+}; /* End of 'mesh_list' class */
+
+/* Load Wavefront OBJ model to scene function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - model file name:
+ *      const std::string &FileName;
+ *   - material for faces without 'usemtl':
+ *      const surface &DefMtl;
+ *   - model bounding box pointer (extended, may be nullptr):
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if model loaded.
+ */
+BOOL gort::LoadOBJ( scene &Scene, const std::string &FileName, const surface &DefMtl, aabb *BB )
+{
+  std::ifstream f(FileName);
+
+  if (!f.is_open())
+    return FALSE;
+
+  std::string Dir = FileName.substr(0, FileName.find_last_of("/\\") + 1), Line;
+  std::vector<vec3> Pos, Nrm;
+  std::vector<vec2> Tex;
+  std::vector<obj_group> Groups(1);
+  std::map<std::string, obj_mtl> Mtls;
+  std::map<std::string, INT> GroupByMtl;
+  std::vector<INT> Face;
+  mesh_list Meshes;
+  INT Cur = 0;
+
+  Groups[0].Mtl = DefMtl;
+
+  // One pass over file: positions and normals are shared, faces go to material groups
+  while (std::getline(f, Line))
+  {
+    const CHAR *S = SkipSpaces(Line.c_str());
+
+    if (S[0] == 'v' && S[1] == ' ')
+      Pos.push_back(ReadVec3(S + 2));
+    else if (S[0] == 'v' && S[1] == 'n' && S[2] == ' ')
+      Nrm.push_back(ReadVec3(S + 3));
+    else if (S[0] == 'v' && S[1] == 't' && S[2] == ' ')
+    {
+      vec3 T = ReadVec3(S + 3);
+
+      // OBJ texture V axis goes up
+      Tex.push_back(vec2(T[0], 1 - T[1]));
+    }
+    else if (S[0] == 'f' && S[1] == ' ')
+    {
+      CHAR *End;
+
+      // corners 'v', 'v/t', 'v//n' or 'v/t/n', negative indices are relative
+      Face.clear();
+      S = SkipSpaces(S + 2);
+      while (*S != 0 && *S != '\r')
+      {
+        INT64 v = strtoll(S, &End, 10), t = 0, n = 0;
+
+        if (End == S)
+          break;
+        S = End;
+        if (*S == '/')
+        {
+          S++;
+          if (*S != '/')
+            t = strtoll(S, &End, 10), S = End;
+          if (*S == '/')
+            n = strtoll(S + 1, &End, 10), S = End;
+        }
+        Face.push_back(v < 0 ? static_cast<INT>(Pos.size() + v) : static_cast<INT>(v - 1));
+        Face.push_back(t < 0 ? static_cast<INT>(Tex.size() + t) : static_cast<INT>(t - 1));
+        Face.push_back(n < 0 ? static_cast<INT>(Nrm.size() + n) : static_cast<INT>(n - 1));
+        S = SkipSpaces(S);
+      }
+
+      // polygons are split into triangle fans
+      for (size_t i = 6; i + 2 < Face.size(); i += 3)
+        Groups[Cur].Corners.insert(Groups[Cur].Corners.end(),
+          {Face[0], Face[1], Face[2], Face[i - 3], Face[i - 2], Face[i - 1], Face[i], Face[i + 1], Face[i + 2]});
+    }
+    else if (strncmp(S, "usemtl", 6) == 0)
+    {
+      std::string Name(SkipSpaces(S + 6));
+
+      while (!Name.empty() && (Name.back() == '\r' || Name.back() == ' '))
+        Name.pop_back();
+
+      auto It = GroupByMtl.find(Name);
+
+      if (It != GroupByMtl.end())
+        Cur = It->second;
+      else
+      {
+        auto Mtl = Mtls.find(Name);
+
+        Cur = GroupByMtl[Name] = static_cast<INT>(Groups.size());
+        Groups.emplace_back();
+        Groups[Cur].Mtl = Mtl != Mtls.end() ? Mtl->second.Mtl : DefMtl;
+        Groups[Cur].Ni = Mtl != Mtls.end() ? Mtl->second.Ni : 1;
+      }
+    }
+    else if (strncmp(S, "mtllib", 6) == 0)
+    {
+      std::string Name(SkipSpaces(S + 6));
+
+      while (!Name.empty() && (Name.back() == '\r' || Name.back() == ' '))
+        Name.pop_back();
+      LoadMTL(Scene, Dir + Name, Mtls);
+    }
+  }
+
+  // Every group gets compact vertex array of used (position, texture, normal) triples
+  for (auto &G : Groups)
+  {
+    std::unordered_map<INT64, INT> Remap, Pairs;
+    std::vector<vec3> V, N;
+    std::vector<vec2> T;
+    std::vector<INT> Ind;
+    BOOL IsN = TRUE, IsT = G.Mtl.Map != nullptr;
+    INT Count = static_cast<INT>(G.Corners.size() / 3);
+
+    for (INT i = 0; i < Count; i++)
+    {
+      INT p = G.Corners[i * 3], t = G.Corners[i * 3 + 1], n = G.Corners[i * 3 + 2];
+
+      if (p < 0 || p >= static_cast<INT>(Pos.size()))
+        break;
+      if (t < 0 || t >= static_cast<INT>(Tex.size()))
+        IsT = FALSE;
+      if (n < 0 || n >= static_cast<INT>(Nrm.size()))
+        IsN = FALSE;
+    }
+    Ind.reserve(Count);
+    for (INT i = 0; i < Count; i++)
+    {
+      INT
+        p = G.Corners[i * 3],
+        t = IsT ? G.Corners[i * 3 + 1] : -1,
+        n = IsN ? G.Corners[i * 3 + 2] : -1;
+
+      if (p < 0 || p >= static_cast<INT>(Pos.size()))
+        return FALSE;
+
+      // (position, normal) pair number is combined with texture index
+      INT64 Key = static_cast<INT64>(p) << 32 | static_cast<UINT>(n);
+
+      if (IsT)
+        Key = static_cast<INT64>(Pairs.insert({Key, static_cast<INT>(Pairs.size())}).first->second) << 32 |
+              static_cast<UINT>(t);
+
+      auto Ins = Remap.insert({Key, static_cast<INT>(V.size())});
+
+      if (Ins.second)
+      {
+        V.push_back(Pos[p]);
+        if (IsN)
+          N.push_back(Nrm[n].Normalizing());
+        if (IsT)
+          T.push_back(Tex[t]);
+      }
+      Ind.push_back(Ins.first->second);
+    }
+    G.Corners = std::vector<INT>();
+    Meshes.Add(std::move(V), std::move(Ind), std::move(N), std::move(T), G.Mtl, G.Ni);
+  }
+  Meshes.Commit(Scene, BB);
+  return TRUE;
+} /* End of 'LoadOBJ' function */
+
+/* G3DM material record (as stored in file) */
+struct G3DMmtl
+{
+  CHAR Name[300];          // Material name
+  FLT Ka[3], Kd[3], Ks[3]; // Ambient, diffuse, specular coefficients (RGB)
+  FLT Ph;                  // Phong power coefficient
+  FLT Trans;               // Transparency factor (1 - opaque)
+  INT Tex[8];              // Texture references (-1 if no texture)
+  CHAR ShaderString[300];  // Additional shader information
+  DWORD Shader;            // Shader number
+}; /* End of 'G3DMmtl' struct */
+
+/* G3DM texture header (as stored in file, texels follow) */
+struct G3DMtex
+{
+  CHAR Name[300];  // Texture name
+  DWORD W, H;      // Texture size
+  DWORD C;         // Texel components count (1 - grey, 3 - BGR, 4 - BGRA)
+}; /* End of 'G3DMtex' struct */
+
+/* Load G3DM model to scene function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - model file name:
+ *      const std::string &FileName;
+ *   - model bounding box pointer (extended, may be nullptr):
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if model loaded.
+ */
+BOOL gort::LoadG3DM( scene &Scene, const std::string &FileName, aabb *BB )
+{
+  std::ifstream f(FileName, std::ifstream::binary);
+  DWORD Sign;
+  INT NumOfPrims, NumOfMtls, NumOfTexs;
+
+  if (!f.read(reinterpret_cast<CHAR *>(&Sign), 4) || Sign != *reinterpret_cast<const DWORD *>("G3DM"))
+    return FALSE;
+  if (!f.read(reinterpret_cast<CHAR *>(&NumOfPrims), 4) || !f.read(reinterpret_cast<CHAR *>(&NumOfMtls), 4) ||
+      !f.read(reinterpret_cast<CHAR *>(&NumOfTexs), 4) || NumOfPrims < 0 || NumOfMtls < 0)
+    return FALSE;
+
+  /* Primitive data (materials are stored after all primitives) */
+  class prim_data
+  {
+  public:
+    std::vector<vec3> V, N;
+    std::vector<vec2> T;
+    std::vector<INT> Ind;
+    DWORD MtlNo;
+  };
+  std::vector<prim_data> Prims(NumOfPrims);
+  std::vector<FLT> Buf;
+  mesh_list Meshes;
+
+  for (auto &Pr : Prims)
+  {
+    DWORD NumOfV, NumOfI;
+
+    if (!f.read(reinterpret_cast<CHAR *>(&NumOfV), 4) || !f.read(reinterpret_cast<CHAR *>(&NumOfI), 4) ||
+        !f.read(reinterpret_cast<CHAR *>(&Pr.MtlNo), 4) || NumOfI % 3 != 0)
+      return FALSE;
+
+    // vertex: position (3), texture (2), normal (3), color (4) floats
+    const INT Stride = 12;
+
+    Buf.resize(static_cast<size_t>(NumOfV) * Stride);
+    if (!f.read(reinterpret_cast<CHAR *>(Buf.data()), Buf.size() * sizeof(FLT)))
+      return FALSE;
+    Pr.V.resize(NumOfV);
+    Pr.N.resize(NumOfV);
+    Pr.T.resize(NumOfV);
+    for (DWORD i = 0; i < NumOfV; i++)
+    {
+      const FLT *v = &Buf[i * Stride];
+
+      Pr.V[i] = vec3(v[0], v[1], v[2]);
+      Pr.T[i] = vec2(v[3], v[4]);
+      Pr.N[i] = vec3(v[5], v[6], v[7]);
+    }
+    Pr.Ind.resize(NumOfI);
+    if (!f.read(reinterpret_cast<CHAR *>(Pr.Ind.data()), NumOfI * sizeof(INT)))
+      return FALSE;
+    for (auto i : Pr.Ind)
+      if (i < 0 || static_cast<DWORD>(i) >= NumOfV)
+        return FALSE;
+  }
+
+  std::vector<G3DMmtl> Mtls(NumOfMtls);
+
+  if (!f.read(reinterpret_cast<CHAR *>(Mtls.data()), NumOfMtls * sizeof(G3DMmtl)))
+    return FALSE;
+
+  // textures are optional: model without readable textures stays untextured
+  std::vector<texture *> Texs(max(NumOfTexs, 0), nullptr);
+  std::vector<BYTE> Texels;
+
+  for (auto &Tex : Texs)
+  {
+    G3DMtex T;
+
+    if (!f.read(reinterpret_cast<CHAR *>(&T), sizeof(G3DMtex)) || T.W == 0 || T.H == 0 ||
+        (T.C != 1 && T.C != 3 && T.C != 4))
+      break;
+    Texels.resize(static_cast<size_t>(T.W) * T.H * T.C);
+    if (!f.read(reinterpret_cast<CHAR *>(Texels.data()), Texels.size()))
+      break;
+
+    std::vector<DWORD> Pixels(static_cast<size_t>(T.W) * T.H);
+
+    for (size_t i = 0; i < Pixels.size(); i++)
+    {
+      const BYTE *t = &Texels[i * T.C];
+
+      Pixels[i] = T.C == 1 ? t[0] * 0x010101u : t[0] | t[1] << 8 | t[2] << 16;
+    }
+    Tex = new texture;
+    Tex->Create(T.W, T.H, Pixels.data());
+    Scene << Tex;
+  }
+
+  for (auto &Pr : Prims)
+  {
+    surface Mtl;
+
+    if (Pr.MtlNo < Mtls.size())
+    {
+      const G3DMmtl &M = Mtls[Pr.MtlNo];
+
+      // file colors are RGB
+      Mtl = surface(vec3(M.Ka[2], M.Ka[1], M.Ka[0]), vec3(M.Kd[2], M.Kd[1], M.Kd[0]), vec3(M.Ks[2], M.Ks[1], M.Ks[0]),
+        M.Ph, 0, mth::Clamp<REAL>(1 - M.Trans, 0, 1));
+      if (M.Tex[0] >= 0 && M.Tex[0] < static_cast<INT>(Texs.size()))
+        Mtl.Map = Texs[M.Tex[0]];
+    }
+    if (Mtl.Map == nullptr)
+      Pr.T.clear();
+    Meshes.Add(std::move(Pr.V), std::move(Pr.Ind), std::move(Pr.N), std::move(Pr.T), Mtl, 1);
+  }
+  Meshes.Commit(Scene, BB);
+  return TRUE;
+} /* End of 'LoadG3DM' function */
+
+/* Load model by file extension function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - model file name ('*.obj' or '*.g3dm'):
+ *      const std::string &FileName;
+ *   - model bounding box pointer (extended, may be nullptr):
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if model loaded.
+ */
+BOOL gort::LoadModel( scene &Scene, const std::string &FileName, aabb *BB )
+{
+  std::string Ext = FileName.substr(FileName.find_last_of('.') + 1);
+
+  for (auto &c : Ext)
+    c = static_cast<CHAR>(tolower(c));
+  if (Ext == "g3dm")
+    return LoadG3DM(Scene, FileName, BB);
+  if (Ext == "obj")
+    return LoadOBJ(Scene, FileName, surface(vec3(0.1), vec3(0.7), vec3(0.3), 16, 0, 0), BB);
+  return FALSE;
+} /* End of 'LoadModel' function */
+
+/* END OF 'models.cpp' FILE */
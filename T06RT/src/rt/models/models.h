@@ -0,0 +1,74 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : models.h
+ * PURPOSE     : Ray tracing project.
+ *               Model files (OBJ, G3DM) import handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __models_h_
+#define __models_h_
+
+#include <string>
+
+#include "../rt.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Load Wavefront OBJ model to scene function.
+   * Faces are grouped by 'usemtl' materials (from 'mtllib' files),
+   * every group is added as one mesh shape.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - model file name:
+   *      const std::string &FileName;
+   *   - material for faces without 'usemtl':
+   *      const surface &DefMtl;
+   *   - model bounding box pointer (extended, may be nullptr):
+   *      aabb *BB;
+   * RETURNS:
+   *   (BOOL) TRUE if model loaded.
+   */
+  BOOL LoadOBJ( scene &Scene, const std::string &FileName, const surface &DefMtl, aabb *BB = nullptr );
+
+  /* Load G3DM model to scene function.
+   * Every model primitive is added as one mesh shape with its material.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - model file name:
+   *      const std::string &FileName;
+   *   - model bounding box pointer (extended, may be nullptr):
+   *      aabb *BB;
+   * RETURNS:
+   *   (BOOL) TRUE if model loaded.
+   */
+  BOOL LoadG3DM( scene &Scene, const std::string &FileName, aabb *BB = nullptr );
+
+  /* Load model by file extension function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - model file name ('*.obj' or '*.g3dm'):
+   *      const std::string &FileName;
+   *   - model bounding box pointer (extended, may be nullptr):
+   *      aabb *BB;
+   * RETURNS:
+   *   (BOOL) TRUE if model loaded.
+   */
+  BOOL LoadModel( scene &Scene, const std::string &FileName, aabb *BB = nullptr );
+} /* end of 'gort' namespace */
+
+#endif /* __models_h_ */
+
+/* END OF 'models.h' FILE */
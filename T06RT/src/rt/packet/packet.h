@@ -0,0 +1,128 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : packet.h
+ * PURPOSE     : Ray tracing project.
+ *               Coherent rays packet handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __packet_h_
+#define __packet_h_
+
+#include <cmath>
+
+#include "../../def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  // Forward declaration
+  class shape;
+
+  /* Rays in packet (two AVX or four SSE registers of doubles per component) */
+  const INT PacketSize = 8;
+
+  /* All packet lanes mask */
+  const UINT PacketFull = (1u << PacketSize) - 1;
+
+  /* Rays packet class.
+   * Rays are stored as structure of arrays, so every lane loop over
+   * the packet is compiled to vector instructions. Lane 'i' takes part
+   * in a query only if bit 'i' of the active mask is set. Lane loops
+   * compute all lanes before masking, so unset lanes are zeroed. */
+  class packet
+  {
+  public:
+    REAL Org[3][PacketSize] {};     // Rays origins
+    REAL Dir[3][PacketSize] {};     // Rays directions
+    REAL InvDir[3][PacketSize] {};  // Rays inversed directions
+    REAL T[PacketSize] {};          // Closest hit distances (HUGE_VAL for no hit)
+    shape *Sh[PacketSize] {};      // Closest hit shapes
+    UINT Active = 0;            // Valid lanes mask
+
+    /* Set packet lane ray function.
+     * ARGUMENTS:
+     *   - lane index:
+     *      INT Lane;
+     *   - ray to be placed:
+     *      const ray &R;
+     * RETURNS: None.
+     */
+    VOID Set( INT Lane, const ray &R )
+    {
+      for (INT i = 0; i < 3; i++)
+      {
+        Org[i][Lane] = R.Org[i];
+        Dir[i][Lane] = R.Dir[i];
+        InvDir[i][Lane] = 1 / R.Dir[i];
+      }
+      T[Lane] = HUGE_VAL;
+      Sh[Lane] = nullptr;
+      Active |= 1u << Lane;
+    } /* End of 'Set' function */
+
+    /* Obtain lane ray function.
+     * ARGUMENTS:
+     *   - lane index:
+     *      INT Lane;
+     * RETURNS:
+     *   (ray) lane ray.
+     */
+    ray Get( INT Lane ) const
+    {
+      ray R;
+
+      R.Org = vec3(Org[0][Lane], Org[1][Lane], Org[2][Lane]);
+      R.Dir = vec3(Dir[0][Lane], Dir[1][Lane], Dir[2][Lane]);
+      return R;
+    } /* End of 'Get' function */
+
+    /* Is packet coherent function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if all active rays have the same direction octant.
+     */
+    BOOL IsCoherent( VOID ) const
+    {
+      INT First = -1;
+
+      for (INT i = 0; i < PacketSize; i++)
+        if (Active & (1u << i))
+        {
+          INT Oct = (Dir[0][i] < 0) | (Dir[1][i] < 0) << 1 | (Dir[2][i] < 0) << 2;
+
+          if (First < 0)
+            First = Oct;
+          else if (Oct != First)
+            return FALSE;
+        }
+      return TRUE;
+    } /* End of 'IsCoherent' function */
+
+    /* Obtain active lanes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) active lanes count.
+     */
+    INT GetCount( VOID ) const
+    {
+      INT n = 0;
+
+      for (UINT m = Active; m != 0; m &= m - 1)
+        n++;
+      return n;
+    } /* End of 'GetCount' function */
+  }; /* End of 'packet' class */
+} /* end of 'gort' namespace */
+
+#endif /* __packet_h_ */
+
+/* END OF 'packet.h' FILE */
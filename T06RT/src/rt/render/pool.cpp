@@ -0,0 +1,162 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : pool.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Work stealing thread pool class functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "pool.h"
+
+/* Pool class constructor.
+ * ARGUMENTS:
+ *   - worker threads count (0 for hardware concurrency):
+ *      INT ThreadCount;
+ */
+gort::pool::pool( INT ThreadCount )
+{
+  if (ThreadCount <= 0)
+    ThreadCount = static_cast<INT>(std::thread::hardware_concurrency());
+  if (ThreadCount <= 0)
+    ThreadCount = 1;
+
+  for (INT i = 0; i < ThreadCount; i++)
+    Queues.push_back(std::make_unique<queue>());
+  for (INT i = 0; i < ThreadCount; i++)
+    Threads.push_back(std::thread(&pool::WorkerMain, this, i));
+} /* End of 'pool' function */
+
+/* Pool class destructor */
+gort::pool::~pool( VOID )
+{
+  {
+    std::lock_guard<std::mutex> lg(Lock);
+    IsExit = TRUE;
+  }
+  StartCV.notify_all();
+  for (auto &Th : Threads)
+    Th.join();
+} /* End of '~pool' function */
+
+/* Obtain next task for worker function.
+ * ARGUMENTS:
+ *   - worker index:
+ *      INT Worker;
+ *   - task index pointer:
+ *      INT *Task;
+ * RETURNS:
+ *   (BOOL) TRUE if task found.
+ */
+BOOL gort::pool::NextTask( INT Worker, INT *Task )
+{
+  INT Count = static_cast<INT>(Queues.size());
+
+  // Own queue first
+  {
+    queue &Q = *Queues[Worker];
+    std::lock_guard<std::mutex> lg(Q.Lock);
+
+    if (!Q.Tasks.empty())
+    {
+      *Task = Q.Tasks.front();
+      Q.Tasks.pop_front();
+      return TRUE;
+    }
+  }
+
+  // Steal from neighbours
+  for (INT i = 1; i < Count; i++)
+  {
+    queue &Q = *Queues[(Worker + i) % Count];
+    std::lock_guard<std::mutex> lg(Q.Lock);
+
+    if (!Q.Tasks.empty())
+    {
+      *Task = Q.Tasks.back();
+      Q.Tasks.pop_back();
+      return TRUE;
+    }
+  }
+  return FALSE;
+} /* End of 'NextTask' function */
+
+/* Worker thread function.
+ * ARGUMENTS:
+ *   - worker index:
+ *      INT Worker;
+ * RETURNS: None.
+ */
+VOID gort::pool::WorkerMain( INT Worker )
+{
+  UINT64 Seen = 0;
+
+  while (TRUE)
+  {
+    {
+      std::unique_lock<std::mutex> ul(Lock);
+
+      StartCV.wait(ul, [&]{ return IsExit || Generation != Seen; });
+      if (IsExit)
+        return;
+      Seen = Generation;
+    }
+
+    INT Task;
+
+    while (NextTask(Worker, &Task))
+      Job(Task, Worker);
+
+    {
+      std::lock_guard<std::mutex> lg(Lock);
+
+      if (--Busy == 0)
+        DoneCV.notify_all();
+    }
+  }
+} /* End of 'WorkerMain' function */
+
+/* Execute tasks and wait for completion function.
+ * ARGUMENTS:
+ *   - tasks count:
+ *      INT TaskCount;
+ *   - task function (task index, worker index):
+ *      const std::function<VOID ( INT, INT )> &Func;
+ * RETURNS: None.
+ */
+VOID gort::pool::Run( INT TaskCount, const std::function<VOID ( INT, INT )> &Func )
+{
+  std::lock_guard<std::mutex> rl(RunLock);
+  INT Count = static_cast<INT>(Queues.size());
+
+  if (TaskCount <= 0)
+    return;
+
+  // Contiguous task ranges per worker keep neighbour tiles on one core
+  for (INT i = 0; i < Count; i++)
+  {
+    queue &Q = *Queues[i];
+    std::lock_guard<std::mutex> lg(Q.Lock);
+
+    for (INT t = TaskCount * i / Count; t < TaskCount * (i + 1) / Count; t++)
+      Q.Tasks.push_back(t);
+  }
+
+  std::unique_lock<std::mutex> ul(Lock);
+
+  Job = Func;
+  Busy = Count;
+  Generation++;
+  StartCV.notify_all();
+  DoneCV.wait(ul, [&]{ return Busy == 0; });
+  Job = nullptr;
+} /* End of 'Run' function */
+
+/* END OF 'pool.cpp' FILE */
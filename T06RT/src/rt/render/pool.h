@@ -0,0 +1,116 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : pool.h
+ * PURPOSE     : Ray tracing project.
+ *               Work stealing thread pool handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __pool_h_
+#define __pool_h_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Persistent thread pool class.
+   * Every worker owns a deque of task indices: owner takes tasks from
+   * the front, idle workers steal from the back of other deques. */
+  class pool
+  {
+  private:
+    /* Worker task queue class */
+    class queue
+    {
+    public:
+      std::mutex Lock;        // Queue lock
+      std::deque<INT> Tasks;  // Task indices
+    }; /* End of 'queue' class */
+
+    std::vector<std::thread> Threads;             // Worker threads
+    std::vector<std::unique_ptr<queue>> Queues;   // Per worker queues
+    std::function<VOID ( INT, INT )> Job;         // Current job (task index, worker index)
+
+    std::mutex RunLock;                  // Lock for simultaneous 'Run' calls
+    std::mutex Lock;                     // Pool state lock
+    std::condition_variable StartCV;     // New job notification
+    std::condition_variable DoneCV;      // Job completion notification
+    UINT64 Generation = 0;               // Job number
+    INT Busy = 0;                        // Workers handling current job
+    BOOL IsExit = FALSE;                 // Pool shutdown flag
+
+    /* Obtain next task for worker function.
+     * ARGUMENTS:
+     *   - worker index:
+     *      INT Worker;
+     *   - task index pointer:
+     *      INT *Task;
+     * RETURNS:
+     *   (BOOL) TRUE if task found.
+     */
+    BOOL NextTask( INT Worker, INT *Task );
+
+    /* Worker thread function.
+     * ARGUMENTS:
+     *   - worker index:
+     *      INT Worker;
+     * RETURNS: None.
+     */
+    VOID WorkerMain( INT Worker );
+
+  public:
+    /* Pool class constructor.
+     * ARGUMENTS:
+     *   - worker threads count (0 for hardware concurrency):
+     *      INT ThreadCount;
+     */
+    explicit pool( INT ThreadCount = 0 );
+
+    /* Pool class destructor */
+    ~pool( VOID );
+
+    pool( const pool & ) = delete;
+    pool & operator=( const pool & ) = delete;
+
+    /* Execute tasks and wait for completion function.
+     * ARGUMENTS:
+     *   - tasks count:
+     *      INT TaskCount;
+     *   - task function (task index, worker index):
+     *      const std::function<VOID ( INT, INT )> &Func;
+     * RETURNS: None.
+     */
+    VOID Run( INT TaskCount, const std::function<VOID ( INT, INT )> &Func );
+
+    /* Obtain worker threads count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) threads count.
+     */
+    INT GetThreadCount( VOID ) const
+    {
+      return static_cast<INT>(Threads.size());
+    } /* End of 'GetThreadCount' function */
+  }; /* End of 'pool' class */
+} /* end of 'gort' namespace */
+
+#endif /* __pool_h_ */
+
+/* END OF 'pool.h' FILE */
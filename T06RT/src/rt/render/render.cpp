@@ -0,0 +1,564 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : render.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Tile based frame renderer class functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "render.h"
+
+/* Render frame tiles pass function.
+ * Frame is covered by blocks of 'Step' x 'Step' pixels (single pixels
+ * for 'Step' = 1), every block gets one color from 'Spp' samples
+ * around its center shifted by the offset (in block sizes).
+ * Jittered samples take their place in stratum cell from a random
+ * stream of block, pass and sample index.
+ * ARGUMENTS:
+ *   - scene to be rendered:
+ *      scene &Scene;
+ *   - camera:
+ *      const camera &Cam;
+ *   - frame size in pixels:
+ *      INT W, H;
+ *   - block side in pixels:
+ *      INT Step;
+ *   - samples per block:
+ *      INT Spp;
+ *   - samples offset:
+ *      DBL Ox, Oy;
+ *   - pass index (selects jitter random streams):
+ *      INT Pass;
+ *   - tile blocks colors functor (VOID Put( INT Bx, INT By, INT BW, INT BH, const vec3 *Colors ),
+ *     block coordinates, colors by rows):
+ *      const std::function<VOID ( INT, INT, INT, INT, const vec3 * )> &Put;
+ * RETURNS:
+ *   (BOOL) TRUE if pass was not cancelled.
+ */
+BOOL gort::renderer::RenderPass( scene &Scene, const camera &Cam, INT W, INT H, INT Step, INT Spp, DBL Ox, DBL Oy, INT Pass,
+                                 const std::function<VOID ( INT, INT, INT, INT, const vec3 * )> &Put )
+{
+  auto Start = std::chrono::high_resolution_clock::now();
+  INT
+    BW = (W + Step - 1) / Step, BH = (H + Step - 1) / Step,
+    TilesX = (BW + TileSize - 1) / TileSize,
+    TilesY = (BH + TileSize - 1) / TileSize;
+
+  if (!Scene.IsBuilt())
+    Scene.Build(Pool.get());
+  Scene.SetPixelAngle(Cam.Wp / Cam.FrameW * Step / Cam.ProjDist);
+
+  // Stratified samples grid inside block
+  INT
+    SamplesX = static_cast<INT>(ceil(sqrt(static_cast<DBL>(Spp)))),
+    SamplesY = (Spp + SamplesX - 1) / SamplesX;
+  std::vector<UINT64> Rays(Pool->GetThreadCount(), 0);
+  auto Sample =
+    [&]( INT Bx, INT By, INT i, INT j )
+    {
+      DBL Jx = 0.5, Jy = 0.5;
+
+      if (IsJitter)
+      {
+        rnd Rnd(Bx, By, (static_cast<UINT64>(Pass) * SamplesY + j) * SamplesX + i);
+
+        Jx = Rnd.Rnd0();
+        Jy = Rnd.Rnd0();
+      }
+      return Cam.FrameRay(Bx * Step + (Step - 1) * 0.5 + ((i + Jx) / SamplesX - 0.5 + Ox) * Step,
+                          By * Step + (Step - 1) * 0.5 + ((j + Jy) / SamplesY - 0.5 + Oy) * Step);
+    };
+
+  Waves.resize(Pool->GetThreadCount());
+  for (auto &Wave : Waves)
+    Wave.Times = stage_times();
+
+  // Every tile is rendered exactly once by one worker
+  Pool->Run(TilesX * TilesY,
+    [&]( INT Tile, INT Worker )
+    {
+      // cancelled pass leaves remaining tiles
+      if (IsCancel)
+        return;
+      GORT_STAT_TIMER(TILE_TIME);
+
+      INT
+        X0 = Tile % TilesX * TileSize, Y0 = Tile / TilesX * TileSize,
+        X1 = min(X0 + TileSize, BW), Y1 = min(Y0 + TileSize, BH),
+        TW = X1 - X0;
+      UINT64 Rays0 = scene::GetRayCounter();
+      std::vector<vec3> Block(TW * (Y1 - Y0));
+
+      if (IsWavefront)
+      {
+        // Whole tile is one wavefront, samples of pixel follow each other
+        wavefront &Wave = Waves[Worker];
+        auto Gen = std::chrono::high_resolution_clock::now();
+        INT Count = SamplesX * SamplesY;
+
+        Wave.Clear();
+        for (INT y = Y0; y < Y1; y++)
+          for (INT x = X0; x < X1; x++)
+            for (INT j = 0; j < SamplesY; j++)
+              for (INT i = 0; i < SamplesX; i++)
+                Wave.Add(Sample(x, y, i, j), Scene.Air, Scene.GetRayBudget());
+        Wave.Times.Generate += std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Gen).count();
+        Wave.Trace(Scene);
+        for (INT y = Y0, s = 0; y < Y1; y++)
+          for (INT x = X0; x < X1; x++)
+          {
+            vec3 color(0);
+
+            for (INT k = 0; k < Count; k++)
+              color += Wave.GetColor(s++);
+            Block[(y - Y0) * TW + x - X0] = color / Count;
+          }
+      }
+      else if (IsPackets)
+      {
+        // Pixel blocks of packet size, one packet per block sample
+        for (INT by = Y0; by < Y1; by += PacketH)
+          for (INT bx = X0; bx < X1; bx += PacketW)
+          {
+            vec3 Colors[PacketSize], Sum[PacketSize];
+
+            for (auto &c : Sum)
+              c = vec3(0);
+
+            for (INT j = 0; j < SamplesY; j++)
+              for (INT i = 0; i < SamplesX; i++)
+              {
+                packet P;
+
+                for (INT k = 0; k < PacketSize; k++)
+                {
+                  INT x = bx + k % PacketW, y = by + k / PacketW;
+
+                  if (x < X1 && y < Y1)
+                    P.Set(k, Sample(x, y, i, j));
+                }
+                Scene.Trace(P, Scene.Air, Colors);
+                for (INT k = 0; k < PacketSize; k++)
+                  if (P.Active & (1u << k))
+                    Sum[k] += Colors[k];
+              }
+            for (INT k = 0; k < PacketSize; k++)
+            {
+              INT x = bx + k % PacketW, y = by + k / PacketW;
+
+              if (x < X1 && y < Y1)
+                Block[(y - Y0) * TW + x - X0] = Sum[k] / (SamplesX * SamplesY);
+            }
+          }
+      }
+      else
+        for (INT y = Y0; y < Y1; y++)
+          for (INT x = X0; x < X1; x++)
+          {
+            vec3 color(0);
+
+            for (INT j = 0; j < SamplesY; j++)
+              for (INT i = 0; i < SamplesX; i++)
+                color += Scene.Trace(Sample(x, y, i, j), Scene.Air, 1, 0);
+            Block[(y - Y0) * TW + x - X0] = color / (SamplesX * SamplesY);
+          }
+      Put(X0, Y0, TW, Y1 - Y0, Block.data());
+      Rays[Worker] += scene::GetRayCounter() - Rays0;
+    });
+
+  TileCount = TilesX * TilesY;
+  RayCount = 0;
+  for (auto r : Rays)
+    RayCount += r;
+  Stages = stage_times();
+  if (IsWavefront)
+    for (auto &Wave : Waves)
+      Stages += Wave.Times;
+  SampleCount = static_cast<UINT64>(BW) * BH * SamplesX * SamplesY;
+  FrameTime = std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count();
+  FrameStats = stats::Collect();
+  return !IsCancel;
+} /* End of 'RenderPass' function */
+
+/* Render frame function.
+ * ARGUMENTS:
+ *   - scene to be rendered:
+ *      scene &Scene;
+ *   - camera:
+ *      const camera &Cam;
+ *   - destination frame:
+ *      frame &Frame;
+ * RETURNS: None.
+ */
+VOID gort::renderer::Render( scene &Scene, const camera &Cam, frame &Frame )
+{
+  IsCancel = FALSE;
+  IsAccumValid = FALSE;
+  Frame.SetScale(1);
+  if (IsAdaptive)
+  {
+    RenderAdaptive(Scene, Cam, Frame);
+    return;
+  }
+  RenderPass(Scene, Cam, Frame.GetW(), Frame.GetH(), 1, Samples, 0, 0, 0,
+    [&]( INT X0, INT Y0, INT BW, INT BH, const vec3 *Colors )
+    {
+      Frame.PutBlock(X0, Y0, BW, BH, Colors);
+      Frame.Present(X0, Y0, BW, BH);
+    });
+} /* End of 'Render' function */
+
+/* Pixel samples statistics class */
+class pixel_stat
+{
+public:
+  gort::vec3 Sum {0};  // Colors sum
+  DBL L = 0, L2 = 0;   // Clamped luminance sum and squares sum
+  INT N = 0;           // Samples count
+
+  /* Add sample function.
+   * ARGUMENTS:
+   *   - sample color:
+   *      const gort::vec3 &Color;
+   * RETURNS: None.
+   */
+  VOID Add( const gort::vec3 &Color )
+  {
+    DBL l =
+      0.2126 * mth::Clamp<DBL>(Color[0], 0, 1) +
+      0.7152 * mth::Clamp<DBL>(Color[1], 0, 1) +
+      0.0722 * mth::Clamp<DBL>(Color[2], 0, 1);
+
+    Sum += Color;
+    L += l;
+    L2 += l * l;
+    N++;
+  } /* End of 'Add' function */
+
+  /* Obtain pixel mean standard error function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (DBL) standard error of luminance mean.
+   */
+  DBL GetError( VOID ) const
+  {
+    if (N < 2)
+      return HUGE_VAL;
+
+    DBL Var = (L2 - L * L / N) / (N - 1);
+
+    return Var > 0 ? sqrt(Var / N) : 0;
+  } /* End of 'GetError' function */
+}; /* End of 'pixel_stat' class */
+
+/* Render frame with adaptive sampling function.
+ * All pixels get minimal stratified samples first (camera packets are
+ * used for them), then samples count of pixels with luminance error
+ * above target and of their neighbours is doubled until error is
+ * reached, samples limit is reached or frame time budget is over.
+ * ARGUMENTS:
+ *   - scene to be rendered:
+ *      scene &Scene;
+ *   - camera:
+ *      const camera &Cam;
+ *   - destination frame:
+ *      frame &Frame;
+ * RETURNS: None.
+ */
+VOID gort::renderer::RenderAdaptive( scene &Scene, const camera &Cam, frame &Frame )
+{
+  auto Start = std::chrono::high_resolution_clock::now();
+  INT
+    W = Frame.GetW(), H = Frame.GetH(),
+    TilesX = (W + TileSize - 1) / TileSize,
+    TilesY = (H + TileSize - 1) / TileSize,
+    Side = 1;
+
+  if (!Scene.IsBuilt())
+    Scene.Build(Pool.get());
+  Scene.SetPixelAngle(Cam.Wp / Cam.FrameW / Cam.ProjDist);
+
+  while (Side * Side < Samples)
+    Side *= 2;
+
+  INT
+    MaxSpp = Side * Side,
+    MinSpp = min(4, MaxSpp);
+  std::vector<UINT64>
+    Rays(Pool->GetThreadCount(), 0),
+    Spp(Pool->GetThreadCount(), 0);
+  auto Sample =
+    [&]( INT X, INT Y, INT K )
+    {
+      INT Cx, Cy;
+      DBL Jx = 0.5, Jy = 0.5;
+
+      if (IsJitter)
+      {
+        rnd Rnd(X, Y, K);
+
+        Jx = Rnd.Rnd0();
+        Jy = Rnd.Rnd0();
+      }
+      SampleCell(K, Side, &Cx, &Cy);
+      return Cam.FrameRay(X + (Cx + Jx) / Side - 0.5, Y + (Cy + Jy) / Side - 0.5);
+    };
+
+  std::vector<pixel_stat> Stats(static_cast<size_t>(W) * H);
+
+  // Minimal samples of all pixels
+  Pool->Run(TilesX * TilesY,
+    [&]( INT Tile, INT Worker )
+    {
+      if (IsCancel)
+        return;
+      GORT_STAT_TIMER(TILE_TIME);
+
+      INT
+        X0 = Tile % TilesX * TileSize, Y0 = Tile / TilesX * TileSize,
+        X1 = min(X0 + TileSize, W), Y1 = min(Y0 + TileSize, H);
+      UINT64 Rays0 = scene::GetRayCounter();
+
+      for (INT by = Y0; by < Y1; by += PacketH)
+        for (INT bx = X0; bx < X1; bx += PacketW)
+          for (INT k = 0; k < MinSpp; k++)
+            if (IsPackets)
+            {
+              packet P;
+              vec3 Colors[PacketSize];
+
+              for (INT l = 0; l < PacketSize; l++)
+              {
+                INT x = bx + l % PacketW, y = by + l / PacketW;
+
+                if (x < X1 && y < Y1)
+                  P.Set(l, Sample(x, y, k));
+              }
+              Scene.Trace(P, Scene.Air, Colors);
+              for (INT l = 0; l < PacketSize; l++)
+                if (P.Active & (1u << l))
+                  Stats[(by + l / PacketW) * W + bx + l % PacketW].Add(Colors[l]);
+            }
+            else
+              for (INT y = by; y < min(by + PacketH, Y1); y++)
+                for (INT x = bx; x < min(bx + PacketW, X1); x++)
+                  Stats[y * W + x].Add(Scene.Trace(Sample(x, y, k), Scene.Air, 1, 0));
+      Rays[Worker] += scene::GetRayCounter() - Rays0;
+    });
+
+  // Refinement rounds, noisy pixels neighbours are refined too - edge may miss all samples of a pixel.
+  // Noise mask is built for whole frame, so refinement crosses tile edges.
+  std::vector<BOOL> IsNoisy(Stats.size()), IsAny(Pool->GetThreadCount());
+  auto IsOver =
+    [&]( VOID )
+    {
+      return TimeBudget > 0 &&
+        std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count() > TimeBudget;
+    };
+
+  for (INT Goal = MinSpp * 2; Goal <= MaxSpp && !IsCancel && !IsOver(); Goal *= 2)
+  {
+    for (size_t i = 0; i < Stats.size(); i++)
+      IsNoisy[i] = Stats[i].GetError() > TargetError;
+    std::fill(IsAny.begin(), IsAny.end(), FALSE);
+    Pool->Run(TilesX * TilesY,
+      [&]( INT Tile, INT Worker )
+      {
+        if (IsCancel)
+          return;
+        GORT_STAT_TIMER(TILE_TIME);
+
+        INT
+          X0 = Tile % TilesX * TileSize, Y0 = Tile / TilesX * TileSize,
+          X1 = min(X0 + TileSize, W), Y1 = min(Y0 + TileSize, H);
+        UINT64 Rays0 = scene::GetRayCounter();
+
+        for (INT y = Y0; y < Y1; y++)
+        {
+          if (IsOver())
+            break;
+          for (INT x = X0; x < X1; x++)
+          {
+            pixel_stat &St = Stats[y * W + x];
+            BOOL IsRefine = FALSE;
+
+            for (INT ny = max(y - 1, 0); ny <= min(y + 1, H - 1) && !IsRefine; ny++)
+              for (INT nx = max(x - 1, 0); nx <= min(x + 1, W - 1) && !IsRefine; nx++)
+                IsRefine = IsNoisy[ny * W + nx];
+            if (IsRefine)
+              for (IsAny[Worker] = TRUE; St.N < Goal; )
+                St.Add(Scene.Trace(Sample(x, y, St.N), Scene.Air, 1, 0));
+          }
+        }
+        Rays[Worker] += scene::GetRayCounter() - Rays0;
+      });
+    if (std::find(IsAny.begin(), IsAny.end(), TRUE) == IsAny.end())
+      break;
+  }
+
+  // Pixels means to frame (pixels of cancelled first pass have no samples)
+  Pool->Run(TilesX * TilesY,
+    [&]( INT Tile, INT Worker )
+    {
+      if (IsCancel)
+        return;
+
+      INT
+        X0 = Tile % TilesX * TileSize, Y0 = Tile / TilesX * TileSize,
+        X1 = min(X0 + TileSize, W), Y1 = min(Y0 + TileSize, H),
+        TW = X1 - X0;
+      std::vector<vec3> Block(TW * (Y1 - Y0));
+
+      for (INT y = Y0; y < Y1; y++)
+        for (INT x = X0; x < X1; x++)
+        {
+          const pixel_stat &St = Stats[y * W + x];
+
+          Block[(y - Y0) * TW + x - X0] = St.N > 0 ? St.Sum / St.N : vec3(0);
+          Spp[Worker] += St.N;
+        }
+      Frame.PutBlock(X0, Y0, TW, Y1 - Y0, Block.data());
+      Frame.Present(X0, Y0, TW, Y1 - Y0);
+    });
+
+  TileCount = TilesX * TilesY;
+  RayCount = SampleCount = 0;
+  for (INT i = 0; i < Pool->GetThreadCount(); i++)
+    RayCount += Rays[i], SampleCount += Spp[i];
+  Stages = stage_times();
+  FrameTime = std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count();
+  FrameStats = stats::Collect();
+} /* End of 'RenderAdaptive' function */
+
+/* Is camera view the same function.
+ * ARGUMENTS:
+ *   - cameras to be compared:
+ *      const camera &A, &B;
+ * RETURNS:
+ *   (BOOL) TRUE if cameras give the same rays.
+ */
+static BOOL IsSameView( const gort::camera &A, const gort::camera &B )
+{
+  auto IsSame =
+    []( const gort::vec3 &U, const gort::vec3 &V )
+    {
+      return U[0] == V[0] && U[1] == V[1] && U[2] == V[2];
+    };
+
+  return IsSame(A.Loc, B.Loc) && IsSame(A.Dir, B.Dir) && IsSame(A.Up, B.Up) && IsSame(A.Right, B.Right) &&
+    A.ProjDist == B.ProjDist && A.Size == B.Size && A.FrameW == B.FrameW && A.FrameH == B.FrameH;
+} /* End of 'IsSameView' function */
+
+/* Is progressive accumulation outdated function.
+ * ARGUMENTS:
+ *   - scene to be rendered:
+ *      const scene &Scene;
+ *   - camera:
+ *      const camera &Cam;
+ *   - destination frame:
+ *      const frame &Frame;
+ * RETURNS:
+ *   (BOOL) TRUE if scene, camera or frame differ from accumulated ones.
+ */
+BOOL gort::renderer::IsAccumOutdated( const scene &Scene, const camera &Cam, const frame &Frame ) const
+{
+  return !IsAccumValid || Scene.GetVersion() != AccumVersion || !IsSameView(Cam, AccumCam) ||
+    Frame.GetW() != AccumW || Frame.GetH() != AccumH;
+} /* End of 'IsAccumOutdated' function */
+
+/* Render next progressive pass function.
+ * Accumulation restarts when scene version, camera view or frame size
+ * changes: low resolution preview is shown first, then every pass adds
+ * one jittered sample per pixel to the frame float plane and presents
+ * the average.
+ * ARGUMENTS:
+ *   - scene to be rendered:
+ *      scene &Scene;
+ *   - camera:
+ *      const camera &Cam;
+ *   - destination frame:
+ *      frame &Frame;
+ * RETURNS:
+ *   (BOOL) TRUE if frame was changed.
+ */
+BOOL gort::renderer::RenderProgressive( scene &Scene, const camera &Cam, frame &Frame )
+{
+  INT W = Frame.GetW(), H = Frame.GetH();
+
+  IsCancel = FALSE;
+  if (IsAccumOutdated(Scene, Cam, Frame))
+  {
+    IsAccumValid = TRUE;
+    AccumW = W;
+    AccumH = H;
+    AccumCam = Cam;
+    AccumVersion = Scene.GetVersion();
+    PassCount = 0;
+    IsPreviewDone = PreviewScale <= 1;
+  }
+  if (PassCount >= MaxPasses)
+    return FALSE;
+
+  // Blocky preview, not accumulated
+  if (!IsPreviewDone)
+  {
+    INT Step = PreviewScale;
+
+    Frame.SetScale(1);
+    IsPreviewDone = RenderPass(Scene, Cam, W, H, Step, 1, 0, 0, 0,
+      [&]( INT Bx, INT By, INT BW, INT BH, const vec3 *Colors )
+      {
+        INT X0 = Bx * Step, Y0 = By * Step, PW = BW * Step, PH = BH * Step;
+        std::vector<vec3> Block(PW * PH);
+
+        for (INT y = 0; y < PH; y++)
+          for (INT x = 0; x < PW; x++)
+            Block[y * PW + x] = Colors[y / Step * BW + x / Step];
+        Frame.PutBlock(X0, Y0, PW, PH, Block.data());
+        Frame.Present(X0, Y0, PW, PH);
+      });
+    return TRUE;
+  }
+
+  // R2 quasirandom sequence (first pass samples pixel centers), jittered pixels get own offsets
+  DBL
+    Ox = PassCount * 0.7548776662466927, Oy = PassCount * 0.5698402909980532;
+  FLT Scale = 1.0f / (PassCount + 1);
+
+  Ox -= floor(Ox + 0.5);
+  Oy -= floor(Oy + 0.5);
+  if (IsJitter)
+    Ox = Oy = 0;
+
+  // first pass replaces preview, next ones are summed
+  if (RenderPass(Scene, Cam, W, H, 1, 1, Ox, Oy, PassCount,
+        [&]( INT X0, INT Y0, INT BW, INT BH, const vec3 *Colors )
+        {
+          if (PassCount == 0)
+            Frame.PutBlock(X0, Y0, BW, BH, Colors);
+          else
+            Frame.AddBlock(X0, Y0, BW, BH, Colors);
+          Frame.Present(X0, Y0, BW, BH, Scale);
+        }))
+  {
+    PassCount++;
+    Frame.SetScale(Scale);
+  }
+  else
+    IsAccumValid = FALSE;  // part of pixels got cancelled pass sample - restart accumulation
+  return TRUE;
+} /* End of 'RenderProgressive' function */
+
+/* END OF 'render.cpp' FILE */
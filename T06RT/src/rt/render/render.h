@@ -0,0 +1,418 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : render.h
+ * PURPOSE     : Ray tracing project.
+ *               Tile based frame renderer handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __render_h_
+#define __render_h_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../rt_def.h"
+#include "../frame/frame.h"
+#include "pool.h"
+#include "wavefront.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Frame renderer class */
+  class renderer
+  {
+  private:
+    std::unique_ptr<pool> Pool;  // Rendering threads
+    INT TileSize = 16;           // Tile side in pixels
+    INT Samples = 1;             // Samples per pixel
+    BOOL IsPackets = TRUE;       // Trace camera rays by packets
+    BOOL IsWavefront = FALSE;    // Trace tiles by wavefront ray queues
+    BOOL IsAdaptive = FALSE;     // Add samples to noisy pixels only
+    BOOL IsJitter = FALSE;       // Jitter samples inside their strata
+    DBL TargetError = 0.01;      // Adaptive sampling pixel error target
+    DBL TimeBudget = 0;          // Adaptive sampling time limit in seconds (0 for none)
+    std::vector<wavefront> Waves;  // Per worker wavefront tracers
+
+    static const INT PacketW = 4;                      // Packet pixel block width
+    static const INT PacketH = PacketSize / PacketW;   // Packet pixel block height
+
+    // Last frame statistics
+    INT TileCount = 0;       // Tiles in frame
+    DBL FrameTime = 0;       // Frame render time in seconds
+    stats FrameStats;        // Last frame statistics (all threads)
+    UINT64 RayCount = 0;     // Traced rays in frame
+    stage_times Stages;      // Wavefront stages time
+    UINT64 SampleCount = 0;  // Camera samples in frame
+
+    // Progressive rendering state
+    std::atomic<BOOL> IsCancel {FALSE};  // Current pass cancel flag
+    BOOL IsAccumValid = FALSE;           // Is frame plane keeping accumulated passes
+    INT AccumW = 0, AccumH = 0;          // Frame size of accumulated passes
+    camera AccumCam;                     // Camera of accumulated passes
+    UINT64 AccumVersion = 0;             // Scene version of accumulated passes
+    INT PassCount = 0;                   // Accumulated passes
+    INT MaxPasses = 256;                 // Passes to stop accumulation after
+    INT PreviewScale = 4;                // Preview block side in pixels (1 for no preview)
+    BOOL IsPreviewDone = FALSE;          // Is preview shown for accumulation
+
+    /* Render frame tiles pass function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - frame size in pixels:
+     *      INT W, H;
+     *   - block side in pixels:
+     *      INT Step;
+     *   - samples per block:
+     *      INT Spp;
+     *   - samples offset:
+     *      DBL Ox, Oy;
+     *   - pass index (selects jitter random streams):
+     *      INT Pass;
+     *   - tile blocks colors functor (VOID Put( INT Bx, INT By, INT BW, INT BH, const vec3 *Colors ),
+     *     block coordinates, colors by rows):
+     *      const std::function<VOID ( INT, INT, INT, INT, const vec3 * )> &Put;
+     * RETURNS:
+     *   (BOOL) TRUE if pass was not cancelled.
+     */
+    BOOL RenderPass( scene &Scene, const camera &Cam, INT W, INT H, INT Step, INT Spp, DBL Ox, DBL Oy, INT Pass,
+                     const std::function<VOID ( INT, INT, INT, INT, const vec3 * )> &Put );
+
+    /* Render frame with adaptive sampling function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - destination frame:
+     *      frame &Frame;
+     * RETURNS: None.
+     */
+    VOID RenderAdaptive( scene &Scene, const camera &Cam, frame &Frame );
+
+  public:
+    /* Renderer class constructor.
+     * ARGUMENTS:
+     *   - rendering threads count (0 for hardware concurrency):
+     *      INT ThreadCount;
+     */
+    explicit renderer( INT ThreadCount = 0 ) : Pool(std::make_unique<pool>(ThreadCount))
+    {
+    } /* End of 'renderer' function */
+
+    /* Set rendering threads count function.
+     * ARGUMENTS:
+     *   - new threads count (0 for hardware concurrency):
+     *      INT ThreadCount;
+     * RETURNS: None.
+     */
+    VOID SetThreads( INT ThreadCount )
+    {
+      Pool = std::make_unique<pool>(ThreadCount);
+    } /* End of 'SetThreads' function */
+
+    /* Set tile size function.
+     * ARGUMENTS:
+     *   - new tile side in pixels:
+     *      INT NewTileSize;
+     * RETURNS: None.
+     */
+    VOID SetTileSize( INT NewTileSize )
+    {
+      TileSize = NewTileSize > 0 ? NewTileSize : 16;
+    } /* End of 'SetTileSize' function */
+
+    /* Set samples per pixel function.
+     * ARGUMENTS:
+     *   - new samples count (rounded up to a stratified grid):
+     *      INT NewSamples;
+     * RETURNS: None.
+     */
+    VOID SetSamples( INT NewSamples )
+    {
+      Samples = NewSamples > 0 ? NewSamples : 1;
+    } /* End of 'SetSamples' function */
+
+    /* Set camera rays packet tracing function.
+     * ARGUMENTS:
+     *   - packet tracing flag (FALSE for scalar tracing of every ray):
+     *      BOOL NewIsPackets;
+     * RETURNS: None.
+     */
+    VOID SetPackets( BOOL NewIsPackets )
+    {
+      IsPackets = NewIsPackets;
+    } /* End of 'SetPackets' function */
+
+    /* Set wavefront tracing function.
+     * ARGUMENTS:
+     *   - wavefront tracing flag (overrides packet and scalar tracing):
+     *      BOOL NewIsWavefront;
+     * RETURNS: None.
+     */
+    VOID SetWavefront( BOOL NewIsWavefront )
+    {
+      IsWavefront = NewIsWavefront;
+    } /* End of 'SetWavefront' function */
+
+    /* Set adaptive sampling function.
+     * Samples count set by 'SetSamples' becomes maximal samples per
+     * pixel (rounded up to a power of 4).
+     * ARGUMENTS:
+     *   - adaptive sampling flag:
+     *      BOOL NewIsAdaptive;
+     *   - standard error of pixel luminance to stop sampling at:
+     *      DBL NewTargetError;
+     *   - frame time limit in seconds (0 for none), pixels
+     *     get minimal samples count after it:
+     *      DBL NewTimeBudget;
+     * RETURNS: None.
+     */
+    VOID SetAdaptive( BOOL NewIsAdaptive, DBL NewTargetError = 0.01, DBL NewTimeBudget = 0 )
+    {
+      IsAdaptive = NewIsAdaptive;
+      TargetError = NewTargetError > 0 ? NewTargetError : 0;
+      TimeBudget = NewTimeBudget > 0 ? NewTimeBudget : 0;
+    } /* End of 'SetAdaptive' function */
+
+    /* Set samples jitter function.
+     * Jittered sample is placed randomly inside its stratum cell instead
+     * of the cell center. Random numbers come from the pixel and sample
+     * index, so images do not depend on threads count.
+     * ARGUMENTS:
+     *   - jitter flag:
+     *      BOOL NewIsJitter;
+     * RETURNS: None.
+     */
+    VOID SetJitter( BOOL NewIsJitter )
+    {
+      IsJitter = NewIsJitter;
+    } /* End of 'SetJitter' function */
+
+    /* Is wavefront tracing used function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) wavefront tracing flag.
+     */
+    BOOL IsWavefrontUsed( VOID ) const
+    {
+      return IsWavefront;
+    } /* End of 'IsWavefrontUsed' function */
+
+    /* Build scene acceleration structure with rendering threads function.
+     * ARGUMENTS:
+     *   - scene to be built:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID Build( scene &Scene )
+    {
+      Scene.Build(Pool.get());
+    } /* End of 'Build' function */
+
+    /* Render frame function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - destination frame:
+     *      frame &Frame;
+     * RETURNS: None.
+     */
+    VOID Render( scene &Scene, const camera &Cam, frame &Frame );
+
+    /* Render next progressive pass function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - destination frame:
+     *      frame &Frame;
+     * RETURNS:
+     *   (BOOL) TRUE if frame was changed.
+     */
+    BOOL RenderProgressive( scene &Scene, const camera &Cam, frame &Frame );
+
+    /* Is progressive accumulation outdated function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      const scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - destination frame:
+     *      const frame &Frame;
+     * RETURNS:
+     *   (BOOL) TRUE if scene, camera or frame differ from accumulated ones.
+     */
+    BOOL IsAccumOutdated( const scene &Scene, const camera &Cam, const frame &Frame ) const;
+
+    /* Is progressive image complete function.
+     * ARGUMENTS:
+     *   - scene to be rendered:
+     *      const scene &Scene;
+     *   - camera:
+     *      const camera &Cam;
+     *   - destination frame:
+     *      const frame &Frame;
+     * RETURNS:
+     *   (BOOL) TRUE if all passes are accumulated for this scene, camera and frame.
+     */
+    BOOL IsConverged( const scene &Scene, const camera &Cam, const frame &Frame ) const
+    {
+      return PassCount >= MaxPasses && !IsAccumOutdated(Scene, Cam, Frame);
+    } /* End of 'IsConverged' function */
+
+    /* Cancel current pass function.
+     * Safe to call from any thread, the rendering thread stops after
+     * current tiles.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Cancel( VOID )
+    {
+      IsCancel = TRUE;
+    } /* End of 'Cancel' function */
+
+    /* Set progressive passes count function.
+     * ARGUMENTS:
+     *   - passes to stop accumulation after:
+     *      INT NewMaxPasses;
+     * RETURNS: None.
+     */
+    VOID SetMaxPasses( INT NewMaxPasses )
+    {
+      MaxPasses = NewMaxPasses > 0 ? NewMaxPasses : 1;
+    } /* End of 'SetMaxPasses' function */
+
+    /* Set progressive preview scale function.
+     * ARGUMENTS:
+     *   - preview block side in pixels (1 for no preview):
+     *      INT NewPreviewScale;
+     * RETURNS: None.
+     */
+    VOID SetPreviewScale( INT NewPreviewScale )
+    {
+      PreviewScale = NewPreviewScale > 0 ? NewPreviewScale : 1;
+    } /* End of 'SetPreviewScale' function */
+
+    /* Obtain accumulated passes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) passes count.
+     */
+    INT GetPassCount( VOID ) const
+    {
+      return PassCount;
+    } /* End of 'GetPassCount' function */
+
+    /* Obtain rendering threads count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) threads count.
+     */
+    INT GetThreads( VOID ) const
+    {
+      return Pool->GetThreadCount();
+    } /* End of 'GetThreads' function */
+
+    /* Obtain last frame statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stats &) statistics of all threads (zero without 'GORT_STATS').
+     */
+    const stats & GetStats( VOID ) const
+    {
+      return FrameStats;
+    } /* End of 'GetStats' function */
+
+    /* Obtain last frame render time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) frame time in seconds.
+     */
+    DBL GetFrameTime( VOID ) const
+    {
+      return FrameTime;
+    } /* End of 'GetFrameTime' function */
+
+    /* Obtain last frame tiles count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) tiles count.
+     */
+    INT GetTileCount( VOID ) const
+    {
+      return TileCount;
+    } /* End of 'GetTileCount' function */
+
+    /* Obtain last frame traced rays count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) rays count.
+     */
+    UINT64 GetRayCount( VOID ) const
+    {
+      return RayCount;
+    } /* End of 'GetRayCount' function */
+
+    /* Obtain last frame wavefront stages time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stage_times &) stages time summed over workers (zero for other tracing modes).
+     */
+    const stage_times & GetStageTimes( VOID ) const
+    {
+      return Stages;
+    } /* End of 'GetStageTimes' function */
+
+    /* Obtain last frame camera samples count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) samples count.
+     */
+    UINT64 GetSampleCount( VOID ) const
+    {
+      return SampleCount;
+    } /* End of 'GetSampleCount' function */
+
+    /* Obtain last frame rays throughput function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) rays per second.
+     */
+    DBL GetRaysPerSec( VOID ) const
+    {
+      return FrameTime > 0 ? RayCount / FrameTime : 0;
+    } /* End of 'GetRaysPerSec' function */
+
+    /* Obtain last frame tiles throughput function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) tiles per second.
+     */
+    DBL GetTilesPerSec( VOID ) const
+    {
+      return FrameTime > 0 ? TileCount / FrameTime : 0;
+    } /* End of 'GetTilesPerSec' function */
+  }; /* End of 'renderer' class */
+} /* end of 'gort' namespace */
+
+#endif /* __render_h_ */
+
+/* END OF 'render.h' FILE */
@@ -0,0 +1,222 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : wavefront.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Wavefront (ray queues) tracer class functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "wavefront.h"
+
+/* Obtain seconds since moment function.
+ * ARGUMENTS:
+ *   - start moment (set to current moment):
+ *       std::chrono::high_resolution_clock::time_point &Start;
+ * RETURNS:
+ *   (DBL) elapsed seconds.
+ */
+static DBL Lap( std::chrono::high_resolution_clock::time_point &Start )
+{
+  auto Now = std::chrono::high_resolution_clock::now();
+  DBL Sec = std::chrono::duration<DBL>(Now - Start).count();
+
+  Start = Now;
+  return Sec;
+} /* End of 'Lap' function */
+
+/* Find closest hits of current rays function.
+ * Camera rays are grouped by direction octant and intersected by
+ * packets of neighbour queue entries, secondary rays are too divergent
+ * for packets and are intersected one by one.
+ * ARGUMENTS:
+ *   - scene to be traced:
+ *      scene &Scene;
+ * RETURNS: None.
+ */
+VOID gort::wavefront::Intersect( scene &Scene )
+{
+  INT Count = static_cast<INT>(Rays.size());
+
+  Hits.assign(Count, hit());
+  scene::CountRays(Count);
+#ifdef GORT_STATS
+  for (auto &WR : Rays)
+    GORT_STAT_RAY(WR.Depth);
+#endif /* GORT_STATS */
+
+  if (Rays[0].Depth > 0)
+  {
+    for (INT i = 0; i < Count; i++)
+      if (!Scene.Intersection(Rays[i].R, &Hits[i]))
+        Hits[i].Sh = nullptr;
+    return;
+  }
+
+  // counting sort by octant keeps generation order inside octant
+  INT Start[8 + 1] = {0};
+  auto Octant =
+    []( const ray &R )
+    {
+      return (R.Dir[0] < 0) | (R.Dir[1] < 0) << 1 | (R.Dir[2] < 0) << 2;
+    };
+
+  Order.resize(Count);
+  for (auto &WR : Rays)
+    Start[Octant(WR.R) + 1]++;
+  for (INT i = 1; i <= 8; i++)
+    Start[i] += Start[i - 1];
+  for (INT i = 0; i < Count; i++)
+    Order[Start[Octant(Rays[i].R)]++] = i;
+
+  for (INT b = 0; b < Count; b += PacketSize)
+  {
+    packet P;
+    INT Lanes = min(PacketSize, Count - b);
+
+    for (INT k = 0; k < Lanes; k++)
+      P.Set(k, Rays[Order[b + k]].R);
+    Scene.Intersection(P);
+
+    // packet hit has distance and shape only - take the rest from the hit shape
+    for (INT k = 0; k < Lanes; k++)
+    {
+      INT i = Order[b + k];
+
+      if (P.Sh[k] != nullptr && !P.Sh[k]->Intersect(Rays[i].R, &Hits[i]) && !Scene.Intersection(Rays[i].R, &Hits[i]))
+        Hits[i].Sh = nullptr;
+    }
+  }
+} /* End of 'Intersect' function */
+
+/* Order hit rays by shape type, material texture and shape function.
+ * Materials are kept by shapes, so texture is the only material data
+ * shared by different shapes. Missed rays get background color here.
+ * ARGUMENTS:
+ *   - scene to be traced:
+ *      scene &Scene;
+ * RETURNS: None.
+ */
+VOID gort::wavefront::SortHits( scene &Scene )
+{
+  Keys.clear();
+  for (INT i = 0; i < static_cast<INT>(Rays.size()); i++)
+    if (Hits[i].Sh != nullptr)
+      Keys.push_back({&typeid(*Hits[i].Sh), Hits[i].Sh->Mtl.Map, Hits[i].Sh, i});
+    else
+    {
+      GORT_STAT_INC(MISSED_RAYS);
+      Colors[Rays[i].Sample] += Scene.GetBackground() * Rays[i].Weight;
+    }
+
+  // ray index as the last key keeps neighbour rays of one shape together
+  std::sort(Keys.begin(), Keys.end(),
+    []( const hit_key &A, const hit_key &B )
+    {
+      if (A.Type != B.Type)
+        return std::less<const std::type_info *>()(A.Type, B.Type);
+      if (A.Map != B.Map)
+        return std::less<const texture *>()(A.Map, B.Map);
+      if (A.Sh != B.Sh)
+        return std::less<const shape *>()(A.Sh, B.Sh);
+      return A.Ray < B.Ray;
+    });
+  Order.resize(Keys.size());
+  for (size_t i = 0; i < Keys.size(); i++)
+    Order[i] = Keys[i].Ray;
+} /* End of 'SortHits' function */
+
+/* Shade hit rays function.
+ * Shadow rays get the light part, that is lost in shadow, and are
+ * tested by the next stage. New rays use budget of their camera sample.
+ * ARGUMENTS:
+ *   - scene to be traced:
+ *      scene &Scene;
+ * RETURNS: None.
+ */
+VOID gort::wavefront::ShadeHits( scene &Scene )
+{
+  REAL Factor = Scene.GetShadowFactor();
+
+  NextRays.clear();
+  Shadows.clear();
+  for (INT i : Order)
+  {
+    const wave_ray &WR = Rays[i];
+    intr intersection(WR.R, Hits[i]);
+
+    intersection.Length = WR.Length + Hits[i].T;
+    Colors[WR.Sample] += Scene.Shade(WR.R.Dir, WR.Media, &intersection, WR.Weight, WR.Depth + 1,
+      [&]( const ray &R, REAL Dist, const vec3 &Color )
+      {
+        Shadows.push_back({R, Dist, Color * ((1 - Factor) * WR.Weight), WR.Sample});
+        return Color * Factor;
+      },
+      [&]( const ray &R, const envi &Media, REAL Weight, INT Depth )
+      {
+        wave_ray NR;
+
+        NR.R = R;
+        NR.Media = Media;
+        NR.Weight = Weight;
+        NR.Depth = Depth;
+        NR.Length = intersection.Length;
+        NR.Sample = WR.Sample;
+        if (Budget[WR.Sample] > 0 && Scene.Survive(NR))
+        {
+          Budget[WR.Sample]--;
+          NextRays.push_back(NR);
+        }
+      });
+  }
+} /* End of 'ShadeHits' function */
+
+/* Test queued shadow rays function.
+ * ARGUMENTS:
+ *   - scene to be traced:
+ *      scene &Scene;
+ * RETURNS: None.
+ */
+VOID gort::wavefront::TraceShadows( scene &Scene )
+{
+  for (auto &SR : Shadows)
+    if (!Scene.Occluded(SR.R, SR.Dist))
+      Colors[SR.Sample] += SR.Color;
+} /* End of 'TraceShadows' function */
+
+/* Trace all added camera rays function.
+ * ARGUMENTS:
+ *   - scene to be traced:
+ *      scene &Scene;
+ * RETURNS: None.
+ */
+VOID gort::wavefront::Trace( scene &Scene )
+{
+  auto Start = std::chrono::high_resolution_clock::now();
+
+  while (!Rays.empty())
+  {
+    Intersect(Scene);
+    Times.Intersect += Lap(Start);
+    SortHits(Scene);
+    Times.Sort += Lap(Start);
+    ShadeHits(Scene);
+    Times.Shade += Lap(Start);
+    TraceShadows(Scene);
+    Times.Shadow += Lap(Start);
+    Rays.swap(NextRays);
+  }
+} /* End of 'Trace' function */
+
+/* END OF 'wavefront.cpp' FILE */
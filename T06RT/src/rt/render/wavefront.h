@@ -0,0 +1,207 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : wavefront.h
+ * PURPOSE     : Ray tracing project.
+ *               Wavefront (ray queues) tracer handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __wavefront_h_
+#define __wavefront_h_
+
+#include <typeinfo>
+#include <vector>
+
+#include "../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Wavefront stages time class (seconds summed over workers) */
+  class stage_times
+  {
+  public:
+    DBL Generate = 0;   // Camera rays generation
+    DBL Intersect = 0;  // Closest hits search
+    DBL Sort = 0;       // Rays and hits ordering
+    DBL Shade = 0;      // Hits shading and new rays spawning
+    DBL Shadow = 0;     // Shadow rays tests
+
+    /* Add stages time operator.
+     * ARGUMENTS:
+     *   - times to be added:
+     *      const stage_times &T;
+     * RETURNS:
+     *   (stage_times &) Self-reference.
+     */
+    stage_times & operator+=( const stage_times &T )
+    {
+      Generate += T.Generate;
+      Intersect += T.Intersect;
+      Sort += T.Sort;
+      Shade += T.Shade;
+      Shadow += T.Shadow;
+      return *this;
+    } /* End of 'operator+=' function */
+
+    /* Obtain all stages time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) total time in seconds.
+     */
+    DBL GetTotal( VOID ) const
+    {
+      return Generate + Intersect + Sort + Shade + Shadow;
+    } /* End of 'GetTotal' function */
+  }; /* End of 'stage_times' class */
+
+  /* Wavefront tracer class.
+   * Instead of following one path to its end, all rays of a generation
+   * pass every stage together: the queue is intersected (camera rays by
+   * coherent packets), hits are sorted by shape type, texture and shape,
+   * so the same shape code and data are used for a run of hits, shading
+   * emits shadow rays queue and the next generation queue. One tracer is
+   * used by one worker. */
+  class wavefront
+  {
+  private:
+    /* Queued path ray class */
+    class wave_ray : public path_ray
+    {
+    public:
+      INT Sample;  // Camera sample index
+    }; /* End of 'wave_ray' class */
+
+    /* Queued shadow ray class */
+    class shadow_ray
+    {
+    public:
+      ray R;       // Ray to light
+      REAL Dist;   // Distance to light
+      vec3 Color;  // Weighted light color added for unblocked ray
+      INT Sample;  // Camera sample index
+    }; /* End of 'shadow_ray' class */
+
+    /* Hit shading order key class */
+    class hit_key
+    {
+    public:
+      const std::type_info *Type;  // Hit shape type
+      const texture *Map;          // Hit material texture
+      const shape *Sh;             // Hit shape
+      INT Ray;                     // Ray index (keeps generation order)
+    }; /* End of 'hit_key' class */
+
+    std::vector<wave_ray> Rays, NextRays;  // Current and next generation rays
+    std::vector<shadow_ray> Shadows;       // Current generation shadow rays
+    std::vector<hit> Hits;                 // Closest hits of current rays
+    std::vector<INT> Order;                // Rays processing order
+    std::vector<hit_key> Keys;             // Hit rays order keys
+    std::vector<INT> Budget;               // Rays left to every camera sample
+    std::vector<vec3> Colors;              // Camera samples colors
+
+    /* Find closest hits of current rays function.
+     * ARGUMENTS:
+     *   - scene to be traced:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID Intersect( scene &Scene );
+
+    /* Order hit rays by shape type, material texture and shape function.
+     * ARGUMENTS:
+     *   - scene to be traced:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID SortHits( scene &Scene );
+
+    /* Shade hit rays function.
+     * ARGUMENTS:
+     *   - scene to be traced:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID ShadeHits( scene &Scene );
+
+    /* Test queued shadow rays function.
+     * ARGUMENTS:
+     *   - scene to be traced:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID TraceShadows( scene &Scene );
+
+  public:
+    stage_times Times;  // Stages time of this tracer
+
+    /* Start new camera rays set function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID )
+    {
+      Rays.clear();
+      Budget.clear();
+      Colors.clear();
+    } /* End of 'Clear' function */
+
+    /* Add camera ray function.
+     * ARGUMENTS:
+     *   - camera ray:
+     *      const ray &R;
+     *   - ray enviroment:
+     *      const envi &Media;
+     *   - rays limit of the sample:
+     *      INT RayBudget;
+     * RETURNS:
+     *   (INT) camera sample index.
+     */
+    INT Add( const ray &R, const envi &Media, INT RayBudget )
+    {
+      wave_ray WR;
+
+      WR.R = R;
+      WR.Media = Media;
+      WR.Weight = 1;
+      WR.Depth = 0;
+      WR.Sample = static_cast<INT>(Colors.size());
+      Rays.push_back(WR);
+      Budget.push_back(RayBudget - 1);
+      Colors.push_back(vec3(0));
+      return WR.Sample;
+    } /* End of 'Add' function */
+
+    /* Trace all added camera rays function.
+     * ARGUMENTS:
+     *   - scene to be traced:
+     *      scene &Scene;
+     * RETURNS: None.
+     */
+    VOID Trace( scene &Scene );
+
+    /* Obtain camera sample color function.
+     * ARGUMENTS:
+     *   - camera sample index:
+     *      INT Sample;
+     * RETURNS:
+     *   (const vec3 &) sample color.
+     */
+    const vec3 & GetColor( INT Sample ) const
+    {
+      return Colors[Sample];
+    } /* End of 'GetColor' function */
+  }; /* End of 'wavefront' class */
+} /* end of 'gort' namespace */
+
+#endif /* __wavefront_h_ */
+
+/* END OF 'wavefront.h' FILE */
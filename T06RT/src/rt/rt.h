@@ -21,8 +21,13 @@
 #include "./shapes/plane/plane.h"
 #include "./shapes/box/box.h"
 #include "./shapes/triangle/triangle.h"
+#include "./shapes/mesh/mesh.h"
+#include "./shapes/instance/instance.h"
 
 #include "./lights/point.h"
+#include "./lights/spot.h"
+#include "./lights/direction.h"
+#include "./lights/area.h"
 
 #endif /* __rt_h_ */
 
@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Ray tracing handle module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 02.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -17,9 +17,16 @@
 #ifndef __rt_def_h_
 #define __rt_def_h_
 
+#include <cmath>
+#include <cstring>
 #include <vector>
 
 #include "../def.h"
+#include "./bvh/bvh.h"
+#include "./lights/light_tree.h"
+#include "./shapes/packed/packed.h"
+#include "./stats/stats.h"
+#include "./textures/texture.h"
 
 /* Space gort namespace */
 namespace gort
@@ -27,45 +34,57 @@ namespace gort
   // Forward declaration
   class shape;
 
-  const DBL Threshold = 1e-9;  // to correct dbl error
-
-  /* Intersection class */
-  class intr
+  /* Obtain secondary ray origin function.
+   * Offset grows with point coordinates, because absolute rounding
+   * error of hit point does.
+   * ARGUMENTS:
+   *   - surface point:
+   *      const vec3 &P;
+   *   - new ray direction:
+   *      const vec3 &Dir;
+   * RETURNS:
+   *   (vec3) ray origin moved off the surface.
+   */
+  inline vec3 RayOrigin( const vec3 &P, const vec3 &Dir )
   {
-  public:
-    DBL T;  // distance to intersection
-    shape *Sh;  // shape pointer
+    REAL Scale = 1;
 
-    vec3 N;    // Shape normal
-    BOOL IsN;  // Is shape normal evaluated
+    for (INT i = 0; i < 3; i++)
+      if (fabs(P[i]) > Scale)
+        Scale = fabs(P[i]);
+    return P + Dir * (Threshold * Scale);
+  } /* End of 'RayOrigin' function */
 
-    vec3 P;    // Point of intersection
-    BOOL IsP;  // Is point of intersection evaluated
-
-    // addons
-    INT I[5];
-    DBL D[5];
+  /* Hit candidate class.
+   * Filled by shapes during traversal: only what is needed to tell
+   * the closest hit and to resolve its attributes later. */
+  class hit
+  {
+  public:
+    REAL T = HUGE_VAL;    // distance to intersection
+    shape *Sh = nullptr;  // shape pointer
+    INT Prim = 0;         // shape primitive (mesh triangle, box face)
+    REAL U = 0, V = 0;    // primitive barycentric coordinates
+  }; /* End of 'hit' class */
 
-    /* Default constructor */
-    intr( VOID ) : Sh(nullptr), IsN(FALSE), IsP(FALSE)
-    {
-    } /* End of 'intr' funciton */
-  }; /* End of 'intr' class */
+  /* Intersection class */
+  class intr;
 
   /* Surface class */
   class surface
   {
   public:
     vec3 Ka {0.1}, Kd {0.8}, Ks {0.2}; // ambient, diffuse, specular
-    DBL Ph {1};          // Bui Tong Phong coefficient
-    DBL Kr {0.1}, Kt {0.1};      // reflected, transmitted
+    REAL Ph {1};          // Bui Tong Phong coefficient
+    REAL Kr {0.1}, Kt {0.1};      // reflected, transmitted
+    texture *Map = nullptr;       // ambient and diffuse colors map (owned by scene)
 
     /* Default constructor */
     surface( VOID )
     {
     } /*End of 'surface' function */
 
-    surface( const vec3 &NewKa, const vec3 &NewKd, const vec3 &NewKs, const DBL &NewPh, const DBL &NewKr, const DBL &NewKt )
+    surface( const vec3 &NewKa, const vec3 &NewKd, const vec3 &NewKs, const REAL &NewPh, const REAL &NewKr, const REAL &NewKt )
       : Ka(NewKa), Kd(NewKd), Ks(NewKs), Ph(NewPh), Kr(NewKr), Kt(NewKt)
     {
     } /*End of 'surface' function */
@@ -75,10 +94,10 @@ namespace gort
   class envi
   {
   public:
-    DBL RefractionCoef;
-    DBL DecayCoef;
+    REAL RefractionCoef;
+    REAL DecayCoef;
 
-    envi( const DBL &NewRefractionCoef, const DBL &NewDecayCoef ) : RefractionCoef(NewRefractionCoef), DecayCoef(NewDecayCoef)
+    envi( const REAL &NewRefractionCoef, const REAL &NewDecayCoef ) : RefractionCoef(NewRefractionCoef), DecayCoef(NewDecayCoef)
     {
     }
   }; /* End of 'envi' class */
@@ -90,67 +109,351 @@ namespace gort
     surface Mtl;  // Shape material
     envi Media {0, 0};   // Enviroment coef
 
-    /* Is crossing with shape function.
+    /* Shape destructor (shapes are deleted by scene through base pointers) */
+    virtual ~shape( VOID ) = default;
+
+    /* Find closer crossing with shape function.
+     * Only the hit record is filled, attributes are evaluated by
+     * 'GetNormal' for the closest hit of the whole scene.
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
      * RETURNS:
-     *   (BOOL) Is intersection with shape.
+     *   (BOOL) TRUE if shape is crossed closer than 'H->T'.
      */
-    virtual BOOL Intersect( const ray &R, intr *Intr )
+    virtual BOOL Intersect( const ray &R, hit *H )
     {
       return FALSE;
     } /* End of 'Intersect' funciton */
 
     /* Evaluate shape normal function.
      * ARGUMENTS:
-     *   - intersection data pointer:
+     *   - intersection data pointer (hit and 'P' are set):
      *      intr *Intr;
      * RETURNS: None.
      */
     virtual VOID GetNormal( intr *Intr )
     {
     } /* End of 'GetNormal' funciton */
+
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    virtual BOOL Occluded( const ray &R, REAL MaxT )
+    {
+      hit h;
+
+      h.T = MaxT;
+      return Intersect(R, &h) && h.T >= Threshold;
+    } /* End of 'Occluded' funciton */
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is bounded, FALSE for infinite shapes.
+     */
+    virtual BOOL GetBB( aabb *BB )
+    {
+      return FALSE;
+    } /* End of 'GetBB' funciton */
+
+    /* Crossing rays packet with shape function.
+     * Default implementation intersects lanes one by one.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    virtual VOID IntersectPacket( packet &P, UINT Mask )
+    {
+      for (INT i = 0; i < PacketSize; i++)
+        if (Mask & (1u << i))
+        {
+          hit h;
+
+          h.T = P.T[i];
+          if (Intersect(P.Get(i), &h))
+            P.T[i] = h.T, P.Sh[i] = this;
+        }
+    } /* End of 'IntersectPacket' funciton */
   }; /* End of 'shape' class */
 
+  /* Intersection class (resolved closest hit) */
+  class intr : public hit
+  {
+  public:
+    vec3 N;  // Shape normal
+    vec3 P;  // Point of intersection
+    vec2 Tex;           // Texture coordinates
+    REAL TexScale = 0;  // Texture coordinates change per unit of distance (0 - no coordinates)
+    REAL Length = 0;    // Path length from camera to the point
+
+    /* Default constructor */
+    intr( VOID )
+    {
+    } /* End of 'intr' funciton */
+
+    /* Resolve closest hit constructor.
+     * ARGUMENTS:
+     *   - crossed ray:
+     *      const ray &R;
+     *   - closest hit:
+     *      const hit &H;
+     */
+    intr( const ray &R, const hit &H ) : hit(H), P(R(H.T))
+    {
+      Sh->GetNormal(this);
+    } /* End of 'intr' funciton */
+  }; /* End of 'intr' class */
+
   /* Light information class */
   class light_info
   {
   public:
     vec3 L;     // light source direction
     vec3 Color; // light source color
-    DBL Dist;   // distance to light source
+    REAL Dist;   // distance to light source
   }; /* End of 'light_info' class */
 
   /* Light class */
   class light
   {
   protected:
-    DBL Cc, Cl, Cq;
+    REAL Cc, Cl, Cq;
  
   public:
+    /* Light destructor (lights are deleted by scene through base pointers) */
+    virtual ~light( VOID ) = default;
+
     /* Shadow light function.
      * ARGUMENTS:
      *   - position:
      *       HINSTANCE hInstance;
      */
-    virtual DBL Shadow( const vec3 &P, light_info *L )
+    virtual REAL Shadow( const vec3 &P, light_info *L )
     {
       return 0;
     }
+
+    /* Obtain light contribution bound function.
+     * ARGUMENTS:
+     *   - bound pointer:
+     *      light_bound *B;
+     * RETURNS:
+     *   (BOOL) TRUE if light is local, FALSE for lights evaluated at every point.
+     */
+    virtual BOOL GetBound( light_bound *B )
+    {
+      return FALSE;
+    } /* End of 'GetBound' function */
+
+    /* Obtain maximal shadow samples per lit point function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) samples count (1 for lights without area).
+     */
+    virtual INT GetSamples( VOID )
+    {
+      return 1;
+    } /* End of 'GetSamples' function */
+
+    /* Sample light point function.
+     * ARGUMENTS:
+     *   - lit point:
+     *       const vec3 &P;
+     *   - sample coordinates on light in [0, 1):
+     *       REAL U, V;
+     *   - light information:
+     *       light_info *L;
+     * RETURNS:
+     *   (REAL) attenuation of light sample.
+     */
+    virtual REAL Sample( const vec3 &P, REAL U, REAL V, light_info *L )
+    {
+      return Shadow(P, L);
+    } /* End of 'Sample' function */
   }; /* End of 'light' class */
 
+  /* Maximal traced rays per camera ray */
+  const INT MaxRayBudget = 64;
+
+  /* Pending path ray class */
+  class path_ray
+  {
+  public:
+    ray R;        // Ray to be traced
+    envi Media {1, 0};  // Ray enviroment
+    REAL Weight;  // Ray color weight in pixel
+    INT Depth;    // Path depth of the ray
+    REAL Length = 0;  // Path length from camera to ray origin
+  }; /* End of 'path_ray' class */
+
+  /* Pending path rays stack class.
+   * Every traced ray spawns at most two rays, so the stack never holds
+   * more than the rays budget plus one. */
+  class path_stack
+  {
+  public:
+    path_ray Rays[MaxRayBudget + 1];  // Pending rays
+    INT Size = 0;                     // Pending rays count
+
+    /* Add pending ray function.
+     * ARGUMENTS:
+     *   - ray to be traced:
+     *      const ray &R;
+     *   - ray enviroment:
+     *      const envi &Media;
+     *   - ray weight:
+     *      REAL Weight;
+     *   - ray path depth:
+     *      INT Depth;
+     *   - path length from camera to ray origin:
+     *      REAL Length;
+     * RETURNS: None.
+     */
+    VOID Push( const ray &R, const envi &Media, REAL Weight, INT Depth, REAL Length = 0 )
+    {
+      if (Size < MaxRayBudget + 1 && Weight > 0)
+        Rays[Size++] = {R, Media, Weight, Depth, Length};
+    } /* End of 'Push' function */
+
+    /* Take the heaviest pending ray function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (path_ray) ray with the maximal weight.
+     */
+    path_ray Pop( VOID )
+    {
+      INT Best = 0;
+
+      for (INT i = 1; i < Size; i++)
+        if (Rays[i].Weight > Rays[Best].Weight)
+          Best = i;
+
+      path_ray PR = Rays[Best];
+
+      Rays[Best] = Rays[--Size];
+      return PR;
+    } /* End of 'Pop' function */
+  }; /* End of 'path_stack' class */
+
+  /* Obtain path random number function.
+   * Number is hashed from the ray, so images do not depend on
+   * threads and tiles order.
+   * ARGUMENTS:
+   *   - path ray:
+   *      const ray &R;
+   *   - ray path depth:
+   *      INT Depth;
+   * RETURNS:
+   *   (REAL) number in [0, 1).
+   */
+  inline REAL PathRandom( const ray &R, INT Depth )
+  {
+    UINT64 h = 0x9E3779B97F4A7C15ull * (Depth + 1);
+
+    for (INT i = 0; i < 3; i++)
+    {
+      REAL o = R.Org[i], d = R.Dir[i];
+      UINT64 a = 0, b = 0;
+
+      memcpy(&a, &o, sizeof(REAL));
+      memcpy(&b, &d, sizeof(REAL));
+      h = (h ^ a) * 0xBF58476D1CE4E5B9ull;
+      h = (h ^ b) * 0x94D049BB133111EBull;
+      h ^= h >> 31;
+    }
+    return static_cast<REAL>((h >> 11) * (1.0 / 9007199254740992.0));
+  } /* End of 'PathRandom' function */
+
+  /* Obtain point random stream key function.
+   * ARGUMENTS:
+   *   - point:
+   *      const vec3 &P;
+   * RETURNS:
+   *   (UINT64) key hashed from point coordinates.
+   */
+  inline UINT64 PointKey( const vec3 &P )
+  {
+    UINT64 h = 0;
+
+    for (INT i = 0; i < 3; i++)
+    {
+      REAL c = P[i];
+      UINT64 a = 0;
+
+      memcpy(&a, &c, sizeof(REAL));
+      h = rnd::Mix(h ^ a);
+    }
+    return h;
+  } /* End of 'PointKey' function */
+
+  /* Obtain stratified sample cell function.
+   * Cells of 'Side' x 'Side' grid are visited in bit reversed order,
+   * so every 4 first samples cover 4 quarters of the square and so on.
+   * ARGUMENTS:
+   *   - sample number:
+   *      INT K;
+   *   - grid side (power of 2):
+   *      INT Side;
+   *   - cell coordinates pointers:
+   *      INT *Cx, *Cy;
+   * RETURNS: None.
+   */
+  inline VOID SampleCell( INT K, INT Side, INT *Cx, INT *Cy )
+  {
+    *Cx = *Cy = 0;
+    for (INT Bit = Side / 2; Bit > 0; Bit /= 2, K /= 4)
+    {
+      if (K & 1)
+        *Cx += Bit;
+      if (K & 2)
+        *Cy += Bit;
+    }
+  } /* End of 'SampleCell' function */
+
   /* Scene class */
   class scene
   {
   private:
     std::vector<shape *> Shapes;  // shapes container
     std::vector<light *> Lights;  // light container
+    std::vector<texture *> Textures;  // materials textures
+
+    std::vector<light *> LocalLights;   // lights in lights hierarchy (by build index)
+    std::vector<light *> GlobalLights;  // lights evaluated at every point
+    light_tree LightTree;               // lights hierarchy
+    BOOL IsLightsValid = FALSE;         // Is lights hierarchy built for current lights
+    REAL LightCutoff = 1.0 / 1024;      // Light contribution to skip light from
+
+    std::vector<shape *> Bounded;    // shapes in acceleration structure (by primitive index)
+    std::vector<shape *> Unbounded;  // infinite shapes tested separately
+    bvh Accel;                       // shapes hierarchy
+    BOOL IsAccelValid = FALSE;       // Is hierarchy built for current shapes
+    packed_shapes Packed;            // simple shapes arrays (packed storage mode)
+    BOOL IsPacked = FALSE;           // Are simple shapes traced from per type arrays
+    UINT64 Version = 0;              // Shapes and lights changes counter
 
     vec3 AmbientColor, Background;
-    INT MaxRecLevel;  // Recursion in trace level and recursion max level
+    INT MaxRecLevel;             // Maximal path depth (camera ray depth is 0)
+    INT RayBudget = 32;          // Traced rays limit per camera ray (without shadow rays)
+    REAL RouletteWeight = 0.05;  // Path weight to start Russian roulette from
+    REAL ShadowFactor = 0.30;    // Light color part left in shadow
+    REAL PixelAngle = 0;         // Camera pixel angular size (texture footprints spread)
+
+    static inline thread_local UINT64 RayCounter = 0;  // Traced rays by current thread
  
   public:
     envi Air {1, 0}; // Air enviroment coef
@@ -168,34 +471,349 @@ namespace gort
 
       for (auto Lgt : Lights)
         delete Lgt;
+
+      for (auto Tex : Textures)
+        delete Tex;
     } /* End of '~scene' function */
 
-    /* Shade color by parametrs function.
+    /* Build scene acceleration structure function.
+     * ARGUMENTS:
+     *   - hierarchy subtree tasks pool (nullptr to build on calling thread):
+     *      pool *Pool;
+     * RETURNS: None.
+     */
+    VOID Build( pool *Pool = nullptr )
+    {
+      GORT_STAT_TIMER(BUILD_TIME);
+      std::vector<aabb> Boxes;
+
+      Bounded.clear();
+      Unbounded.clear();
+      Packed.Clear();
+      for (auto Sh : Shapes)
+      {
+        aabb BB;
+
+        if (IsPacked && Packed.Add(Sh))
+          continue;
+        if (Sh->GetBB(&BB))
+          Bounded.push_back(Sh), Boxes.push_back(BB);
+        else
+          Unbounded.push_back(Sh);
+      }
+      Accel.Build(Boxes, Pool);
+      Packed.Build(Accel.GetMode(), Pool);
+      IsAccelValid = TRUE;
+
+      std::vector<light_bound> Bounds;
+
+      LocalLights.clear();
+      GlobalLights.clear();
+      for (auto Lgt : Lights)
+      {
+        light_bound B;
+
+        if (Lgt->GetBound(&B))
+          LocalLights.push_back(Lgt), Bounds.push_back(B);
+        else
+          GlobalLights.push_back(Lgt);
+      }
+      LightTree.Build(Bounds);
+      IsLightsValid = TRUE;
+    } /* End of 'Build' function */
+
+    /* Set packed shapes storage function.
+     * Spheres, boxes, triangles and planes are copied to per type arrays
+     * on build and are traced without virtual calls, shape objects
+     * keep giving materials and normals of hits.
+     * ARGUMENTS:
+     *   - packed storage flag:
+     *      BOOL NewIsPacked;
+     * RETURNS: None.
+     */
+    VOID SetPacked( BOOL NewIsPacked )
+    {
+      IsPacked = NewIsPacked;
+      IsAccelValid = FALSE;
+    } /* End of 'SetPacked' function */
+
+    /* Set hierarchy build mode function.
+     * ARGUMENTS:
+     *   - new build mode:
+     *      bvh::mode NewMode;
+     * RETURNS: None.
+     */
+    VOID SetBuildMode( bvh::mode NewMode )
+    {
+      Accel.SetMode(NewMode);
+      IsAccelValid = FALSE;
+    } /* End of 'SetBuildMode' function */
+
+    /* Obtain packed shapes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) shapes traced from per type arrays after last build.
+     */
+    INT GetPackedCount( VOID ) const
+    {
+      return Packed.GetCount();
+    } /* End of 'GetPackedCount' function */
+
+    /* Is packed shapes storage used function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) packed storage flag.
+     */
+    BOOL IsPackedUsed( VOID ) const
+    {
+      return IsPacked;
+    } /* End of 'IsPackedUsed' function */
+
+    /* Obtain scene acceleration structure function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const bvh &) shapes hierarchy.
+     */
+    const bvh & GetAccel( VOID ) const
+    {
+      return Accel;
+    } /* End of 'GetAccel' function */
+
+    /* Obtain packed shapes hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const bvh &) packed shapes hierarchy (empty without packed storage).
+     */
+    const bvh & GetPackedAccel( VOID ) const
+    {
+      return Packed.GetTree();
+    } /* End of 'GetPackedAccel' function */
+
+    /* Obtain scene version function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) number changed by every added shape or light.
+     */
+    UINT64 GetVersion( VOID ) const
+    {
+      return Version;
+    } /* End of 'GetVersion' function */
+
+    /* Mark scene changed function.
+     * Used after shapes or lights are changed in place, shapes and
+     * lights hierarchies are rebuilt by next 'Build'.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Touch( VOID )
+    {
+      IsAccelValid = FALSE;
+      IsLightsValid = FALSE;
+      Version++;
+    } /* End of 'Touch' function */
+
+    /* Obtain rays traced by calling thread function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) traced rays (camera, secondary and shadow) count.
+     */
+    static UINT64 GetRayCounter( VOID )
+    {
+      return RayCounter;
+    } /* End of 'GetRayCounter' function */
+
+    /* Is scene acceleration structure up to date function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if hierarchy is built for all shapes.
+     */
+    BOOL IsBuilt( VOID ) const
+    {
+      return IsAccelValid && IsLightsValid;
+    } /* End of 'IsBuilt' function */
+
+    /* Set traced rays limit per camera ray function.
+     * ARGUMENTS:
+     *   - new rays limit (clamped to [1, MaxRayBudget]):
+     *      INT NewRayBudget;
+     * RETURNS: None.
+     */
+    VOID SetRayBudget( INT NewRayBudget )
+    {
+      RayBudget = mth::Clamp(NewRayBudget, 1, MaxRayBudget);
+    } /* End of 'SetRayBudget' function */
+
+    /* Obtain traced rays limit per camera ray function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) rays limit.
+     */
+    INT GetRayBudget( VOID ) const
+    {
+      return RayBudget;
+    } /* End of 'GetRayBudget' function */
+
+    /* Set maximal path depth function.
+     * ARGUMENTS:
+     *   - new maximal depth (at least 1):
+     *      INT NewMaxRecLevel;
+     * RETURNS: None.
+     */
+    VOID SetMaxRecLevel( INT NewMaxRecLevel )
+    {
+      MaxRecLevel = max(NewMaxRecLevel, 1);
+    } /* End of 'SetMaxRecLevel' function */
+
+    /* Obtain maximal path depth function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) maximal depth.
+     */
+    INT GetMaxRecLevel( VOID ) const
+    {
+      return MaxRecLevel;
+    } /* End of 'GetMaxRecLevel' function */
+
+    /* Set camera pixel angular size function.
+     * Texture footprint of a hit is the pixel cone width at the path
+     * length of the hit, so mip levels are selected without tracing
+     * ray differentials.
+     * ARGUMENTS:
+     *   - pixel size at unit distance from camera (0 - finest mip level everywhere):
+     *      REAL NewPixelAngle;
+     * RETURNS: None.
+     */
+    VOID SetPixelAngle( REAL NewPixelAngle )
+    {
+      PixelAngle = max(NewPixelAngle, 0);
+    } /* End of 'SetPixelAngle' function */
+
+    /* Obtain background color function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const vec3 &) color of rays leaving the scene.
+     */
+    const vec3 & GetBackground( VOID ) const
+    {
+      return Background;
+    } /* End of 'GetBackground' function */
+
+    /* Obtain light part left in shadow function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (REAL) shadow factor.
+     */
+    REAL GetShadowFactor( VOID ) const
+    {
+      return ShadowFactor;
+    } /* End of 'GetShadowFactor' function */
+
+    /* Set light contribution cutoff function.
+     * Local lights attenuated below cutoff at a point are skipped
+     * without shadow ray, 0 keeps all lights.
+     * ARGUMENTS:
+     *   - new cutoff (color component):
+     *      REAL NewLightCutoff;
+     * RETURNS: None.
+     */
+    VOID SetLightCutoff( REAL NewLightCutoff )
+    {
+      LightCutoff = max(NewLightCutoff, 0);
+    } /* End of 'SetLightCutoff' function */
+
+    /* Obtain light contribution cutoff function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (REAL) light contribution cutoff.
+     */
+    REAL GetLightCutoff( VOID ) const
+    {
+      return LightCutoff;
+    } /* End of 'GetLightCutoff' function */
+
+    /* Obtain lights hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const light_tree &) local lights hierarchy.
+     */
+    const light_tree & GetLightTree( VOID ) const
+    {
+      return LightTree;
+    } /* End of 'GetLightTree' function */
+
+    /* Count rays traced outside scene function.
+     * ARGUMENTS:
+     *   - rays count:
+     *      UINT64 Count;
+     * RETURNS: None.
+     */
+    static VOID CountRays( UINT64 Count )
+    {
+      RayCounter += Count;
+    } /* End of 'CountRays' function */
+
+    /* Apply material textures function.
      * ARGUMENTS:
+     *   - intersection data:
+     *      const intr &Intr;
      *   - direction of ray:
      *      const vec3 &Dir;
-     *   - enviroment coefs:
-     *      const envi &Media;
-     *   - intersection data pointer:
-     *      intr *Intr;
-     *   - weight of light:
-     *      const DBL &Weight;
-     *   - recursion level:
-     *      INT RecLevel;
+     *   - mapped material storage:
+     *      surface *Mapped;
      * RETURNS:
-     *   (vec3) new color.
+     *   (const surface &) shape material or mapped material.
      */
-    vec3 Shade( const vec3 &Dir, const envi &Media, intr *Intr, const DBL &Weight, INT RecLevel )
+    const surface & MapSurface( const intr &Intr, const vec3 &Dir, surface *Mapped ) const
     {
-      vec3 color = vec3(0);
-      light_info li;
-      DBL att;
+      const surface &Mtl = Intr.Sh->Mtl;
+
+      if (Mtl.Map == nullptr || Intr.TexScale <= 0)
+        return Mtl;
 
-      color += Intr->Sh->Mtl.Ka * AmbientColor;
+      // pixel cone width projected to the surface, in texture coordinates
+      REAL Footprint = PixelAngle * Intr.Length / max(fabs(Intr.N & Dir) / !Intr.N, 0.125) * Intr.TexScale;
+      vec3 C = Mtl.Map->Sample(Intr.Tex[0], Intr.Tex[1], Footprint);
 
-      for (auto lgt : Lights)
+      *Mapped = Mtl;
+      Mapped->Ka = Mtl.Ka * C;
+      Mapped->Kd = Mtl.Kd * C;
+      return *Mapped;
+    } /* End of 'MapSurface' function */
+
+    /* Shade hit point function.
+     * Local lighting is evaluated here, while shadow rays and secondary
+     * rays are passed to functors, so the same shading serves depth
+     * first and wavefront tracing.
+     * ARGUMENTS:
+     *   - direction of ray:
+     *      const vec3 &Dir;
+     *   - enviroment coefs:
+     *      const envi &Media;
+     *   - intersection data pointer ('Length' is path length to the hit):
+     *      intr *Intr;
+     *   - path weight of the hit:
+     *      REAL Weight;
+     *   - hit path depth:
+     *      INT Depth;
+     *   - light sample functor (vec3 Shadow( const ray &R, REAL Dist, const vec3 &Color )
+     *     returns unweighted light color left after shadow ray test):
+     *      shadow_func Shadow;
+     *   - secondary ray functor
+     *     (VOID Spawn( const ray &R, const envi &Media, REAL Weight, INT Depth )):
+     *      spawn_func Spawn;
+     * RETURNS:
+     *   (vec3) weighted local color.
+     */
+    template<typename shadow_func, typename spawn_func>
+      vec3 Shade( const vec3 &Dir, const envi &Media, intr *Intr, REAL Weight, INT Depth, shadow_func Shadow, spawn_func Spawn )
       {
-        att = lgt->Shadow(Intr->P, &li); //+ li.L * Threshold??
+        GORT_STAT_INC(SHADE_CALLS);
+        surface Mapped;
+        const surface &Mtl = MapSurface(*Intr, Dir, &Mapped);
+        vec3 color = Mtl.Ka * AmbientColor;
+        REAL Decay = exp(-Intr->T * Media.DecayCoef);
+        light_info li;
+        INT AreaCount = 0;
 
         // reverse normal if need
         envi OutMedia = Intr->Sh->Media;
@@ -205,105 +823,481 @@ namespace gort
         // eval reflected vector
         vec3 R = Dir - Intr->N * 2 * (Dir & Intr->N);
 
-        color += li.Color *
-          ((Intr->Sh->Mtl.Kd * max(0, (Intr->N & li.L)) + Intr->Sh->Mtl.Ks * pow(max(0, (R & li.L)), Intr->Sh->Mtl.Ph)) * att +
-           Trace(ray(Intr->P + R * Threshold, R), OutMedia, Weight * Intr->Sh->Mtl.Kr, RecLevel + 1) * Intr->Sh->Mtl.Kr) * exp(-Intr->T * Media.DecayCoef);// * exp(-Intr->T * Media.RefractionCoef) +
-           //Trace(ray(Intr->P + R * Threshold, R), Media, Weight) * Intr->Sh->Mtl.Kt * exp(-Intr->T * Media.DecayCoef));
+        auto Lit =
+          [&]( light *lgt )
+          {
+            // area lights test their samples at once
+            if (lgt->GetSamples() > 1)
+            {
+              color += SampleArea(lgt, *Intr, Mtl, R, AreaCount++) * Decay;
+              return;
+            }
+
+            GORT_STAT_INC(LIGHT_SAMPLES);
+            REAL
+              att = lgt->Shadow(Intr->P, &li),
+              nl = Intr->N & li.L,
+              rl = R & li.L;
+            vec3 c = (Mtl.Kd * max(0, nl) + Mtl.Ks * pow(max(0, rl), Mtl.Ph)) * att;
+
+            // shadow ray only for lights lighting the point
+            if (c[0] <= 0 && c[1] <= 0 && c[2] <= 0)
+              return;
+            color += Shadow(ray(RayOrigin(Intr->P, li.L), li.L), li.Dist, li.Color * c * Decay);
+          };
+
+        // too weak local lights are culled by hierarchy before any shadow ray
+        if (!IsLightsValid)
+          for (auto lgt : Lights)
+            Lit(lgt);
+        else
+        {
+          LightTree.Select(Intr->P, LightCutoff,
+            [&]( INT Light )
+            {
+              Lit(LocalLights[Light]);
+            });
+          for (auto lgt : GlobalLights)
+            Lit(lgt);
+        }
+
+        Spawn(ray(RayOrigin(Intr->P, R), R), OutMedia, Weight * Mtl.Kr * Decay, Depth);
 
         // eval refraction vector
-        DBL n = Intr->Sh->Media.RefractionCoef / Media.RefractionCoef;
-        DBL dn = -Dir & Intr->N;
-        vec3 T = (Dir - Intr->N * (Dir & Intr->N)) * n - Intr->N *  sqrt(1 - (1 - dn * dn) * n * n);
+        REAL n = Intr->Sh->Media.RefractionCoef / Media.RefractionCoef;
+        REAL dn = -Dir & Intr->N;
+        REAL k = 1 - (1 - dn * dn) * n * n;
 
-        color += li.Color * Trace(ray(Intr->P + T * Threshold, T), OutMedia, Weight * Intr->Sh->Mtl.Kt, RecLevel + 1) * Intr->Sh->Mtl.Kt * exp(-Intr->T * Media.DecayCoef);
+        // no refracted ray for total internal reflection and undefined media (NaN direction passes all box tests)
+        if (k >= 0 && std::isfinite(n))
+        {
+          vec3 T = (Dir - Intr->N * (Dir & Intr->N)) * n - Intr->N * sqrt(k);
 
-        intr in;
-        if (Intersection(ray(Intr->P + li.L * Threshold, li.L), &in) && in.T < li.Dist)
-          color *= 0.30;
-      }
+          Spawn(ray(RayOrigin(Intr->P, T), T), OutMedia, Weight * Mtl.Kt * Decay, Depth);
+        }
+
+        return color * Weight;
+      } /* End of 'Shade' function */
 
-      return color * Weight;
+    /* Shade hit point function.
+     * Shadow rays are traced at once, reflected and refracted rays are
+     * spawned once per hit (not per light) to the pending rays stack.
+     * ARGUMENTS:
+     *   - direction of ray:
+     *      const vec3 &Dir;
+     *   - enviroment coefs:
+     *      const envi &Media;
+     *   - intersection data pointer:
+     *      intr *Intr;
+     *   - path weight of the hit:
+     *      REAL Weight;
+     *   - hit path depth:
+     *      INT Depth;
+     *   - pending rays stack:
+     *      path_stack &Stack;
+     * RETURNS:
+     *   (vec3) weighted local color.
+     */
+    vec3 Shade( const vec3 &Dir, const envi &Media, intr *Intr, REAL Weight, INT Depth, path_stack &Stack )
+    {
+      return Shade(Dir, Media, Intr, Weight, Depth,
+        [&]( const ray &R, REAL Dist, const vec3 &Color )
+        {
+          return Occluded(R, Dist) ? Color * ShadowFactor : Color;
+        },
+        [&]( const ray &R, const envi &Media, REAL Weight, INT Depth )
+        {
+          Stack.Push(R, Media, Weight, Depth, Intr->Length);
+        });
     } /* End of 'Shade' function */
 
-    /* Shade color by parametrs function.
+    /* Sample area light function.
+     * Light samples are taken in cells of 'Side' x 'Side' grid (bit
+     * reversed order, jittered by random stream of hit point), shadow
+     * rays of samples are traced by packets. If all rays of the first
+     * packet agree (point is fully lit or in umbra) sampling stops,
+     * penumbra points take all samples of the light.
+     * ARGUMENTS:
+     *   - area light:
+     *      light *Lgt;
+     *   - intersection data (normal faces the ray):
+     *      const intr &Intr;
+     *   - hit point material:
+     *      const surface &Mtl;
+     *   - reflected direction:
+     *      const vec3 &R;
+     *   - area light number at this point (selects random stream):
+     *      INT Number;
+     * RETURNS:
+     *   (vec3) light color average of samples.
+     */
+    vec3 SampleArea( light *Lgt, const intr &Intr, const surface &Mtl, const vec3 &R, INT Number )
+    {
+      INT Side = 1, Count = 0;
+      rnd Rnd(PointKey(Intr.P) + Number);
+      vec3 Sum(0);
+
+      while (Side * Side < Lgt->GetSamples())
+        Side *= 2;
+      while (Count < Side * Side)
+      {
+        packet P;
+        REAL Dist[PacketSize];
+        vec3 Colors[PacketSize];
+        INT First = Count;
+
+        for (INT k = 0; k < PacketSize && Count < Side * Side; k++, Count++)
+        {
+          light_info li;
+          INT Cx, Cy;
+
+          GORT_STAT_INC(LIGHT_SAMPLES);
+          SampleCell(Count, Side, &Cx, &Cy);
+
+          REAL
+            U = (Cx + Rnd.Rnd0()) / Side,
+            V = (Cy + Rnd.Rnd0()) / Side,
+            att = Lgt->Sample(Intr.P, U, V, &li),
+            nl = Intr.N & li.L,
+            rl = R & li.L;
+          vec3 c = (Mtl.Kd * max(0, nl) + Mtl.Ks * pow(max(0, rl), Mtl.Ph)) * att;
+
+          // samples not lighting the point are dark without shadow ray
+          if (c[0] <= 0 && c[1] <= 0 && c[2] <= 0)
+            continue;
+          P.Set(k, ray(RayOrigin(Intr.P, li.L), li.L));
+          Dist[k] = li.Dist;
+          Colors[k] = li.Color * c;
+        }
+
+        UINT Mask = Occluded(P, Dist);
+
+        for (INT k = 0; k < PacketSize; k++)
+          if (P.Active & (1u << k))
+            Sum += Mask & (1u << k) ? Colors[k] * ShadowFactor : Colors[k];
+        if (First == 0 && (Mask == 0 || Mask == P.Active))
+          break;
+      }
+      return Sum / Count;
+    } /* End of 'SampleArea' function */
+
+    /* Should path ray be traced function.
+     * Light paths are ended by Russian roulette when their weight falls
+     * below 'RouletteWeight': one of 'RouletteWeight / Weight' paths
+     * survives with the weight raised to 'RouletteWeight', which keeps
+     * the expected color.
+     * ARGUMENTS:
+     *   - path ray (weight of survived ray may be raised):
+     *      path_ray &PR;
+     * RETURNS:
+     *   (BOOL) TRUE if ray is to be traced.
+     */
+    BOOL Survive( path_ray &PR ) const
+    {
+      if (PR.Depth >= MaxRecLevel || PR.Weight <= Threshold)
+        return FALSE;
+      if (PR.Weight < RouletteWeight)
+      {
+        if (PathRandom(PR.R, PR.Depth) * RouletteWeight >= PR.Weight)
+          return FALSE;
+        PR.Weight = RouletteWeight;
+      }
+      return TRUE;
+    } /* End of 'Survive' function */
+
+    /* Trace pending rays function.
+     * Rays are taken from the stack heaviest first, so when the budget
+     * runs out only the least visible part of the ray tree is lost.
+     * ARGUMENTS:
+     *   - pending rays stack:
+     *      path_stack &Stack;
+     *   - rays to be traced limit:
+     *      INT Budget;
+     * RETURNS:
+     *   (vec3) sum of weighted rays colors.
+     */
+    vec3 Trace( path_stack &Stack, INT Budget )
+    {
+      vec3 color = vec3(0);
+
+      while (Stack.Size > 0 && Budget > 0)
+      {
+        path_ray PR = Stack.Pop();
+
+        if (!Survive(PR))
+          continue;
+
+        RayCounter++;
+        GORT_STAT_RAY(PR.Depth);
+        Budget--;
+        //. . .look for closest intersection
+        hit h;
+        if (Intersection(PR.R, &h))
+        {
+          intr intersection(PR.R, h);
+
+          intersection.Length = PR.Length + h.T;
+          color += Shade(PR.R.Dir, PR.Media, &intersection, PR.Weight, PR.Depth + 1, Stack);
+        }
+        else
+        {
+          GORT_STAT_INC(MISSED_RAYS);
+          color += Background * PR.Weight;
+        }
+      }
+      return color;
+    } /* End of 'Trace' function */
+
+    /* Trace ray function.
      * ARGUMENTS:
      *   - ray from screen:
      *      const ray &R;
      *   - enviroment coefs:
      *      const envi &Media;
      *   - weight of light:
-     *      const DBL &Weight;
-     *   - recursion level:
+     *      REAL Weight;
+     *   - path depth of the ray:
      *      INT RecLevel;
      * RETURNS:
-     *   (vec3) new color.
+     *   (vec3) ray color.
+     */
+    vec3 Trace( const ray &R, const envi &Media, REAL Weight, INT RecLevel )
+    {
+      path_stack Stack;
+
+      Stack.Push(R, Media, Weight, RecLevel);
+      return Trace(Stack, RayBudget);
+    } /* End of 'Trace' function */
+
+    /* Trace coherent camera rays packet function.
+     * Incoherent packets and lanes not confirmed by scalar intersection
+     * fall back to scalar tracing, shading is done per lane.
+     * ARGUMENTS:
+     *   - rays packet:
+     *      packet &P;
+     *   - enviroment coefs:
+     *      const envi &Media;
+     *   - lane colors array:
+     *      vec3 *Colors;
+     * RETURNS: None.
      */
-    vec3 Trace( const ray &R, const envi &Media, DBL Weight, INT RecLevel )
+    VOID Trace( packet &P, const envi &Media, vec3 *Colors )
     {
-      vec3 color = Background;
-      /*
-      vec3 FogColor = vec3(1, 0, 0);//AmbientColor;
-      DBL FogStart = 5;
-      DBL FogEnd = 25;
-      */
-      if (RecLevel < MaxRecLevel && Weight > Threshold)
+      if (!P.IsCoherent())
       {
-        RecLevel++;
-        //. . .look for closest intersection
-        intr intersection;
-        if (Intersection(R, &intersection))
+        for (INT i = 0; i < PacketSize; i++)
+          if (P.Active & (1u << i))
+            Colors[i] = Trace(P.Get(i), Media, 1, 0);
+        return;
+      }
+
+      RayCounter += P.GetCount();
+      Intersection(P);
+      for (INT i = 0; i < PacketSize; i++)
+        if (P.Active & (1u << i))
         {
-          if (!intersection.IsP)
-            intersection.P = R(intersection.T);
-          if (!intersection.IsN)
-            intersection.Sh->GetNormal(&intersection);
-
-          color = Shade(R.Dir, Media, &intersection, Weight, RecLevel);
-
-          /* //???
-          DBL fog = 0;
-          if (intersection.T < FogStart)
-            fog = 1;
-          else if (intersection.T > FogEnd)
-            fog = 0;
-          else
-            fog = (intersection.T - FogStart) / (FogEnd - FogStart);
+          ray R = P.Get(i);
+          hit h;
 
-          color = color * fog + FogColor * (1 - fog);
-          */
+          if (P.Sh[i] == nullptr)
+          {
+            GORT_STAT_RAY(0);
+            GORT_STAT_INC(MISSED_RAYS);
+            Colors[i] = Background;
+          }
+          else if (P.Sh[i]->Intersect(R, &h))
+          {
+            path_stack Stack;
+            intr intersection(R, h);
+
+            intersection.Length = h.T;
+            GORT_STAT_RAY(0);
+            Colors[i] = Shade(R.Dir, Media, &intersection, 1, 1, Stack);
+            Colors[i] += Trace(Stack, RayBudget - 1);
+          }
+          else
+            RayCounter--, Colors[i] = Trace(R, Media, 1, 0);
         }
-        else
-          color = Background;
+    } /* End of 'Trace' function */
 
-        RecLevel--;
+    /* Find closest crossings for rays packet function.
+     * ARGUMENTS:
+     *   - rays packet (fills 'T' and 'Sh' of active lanes):
+     *      packet &P;
+     * RETURNS: None.
+     */
+    VOID Intersection( packet &P )
+    {
+      if (!IsAccelValid)
+      {
+        for (auto Sh : Shapes)
+          Sh->IntersectPacket(P, P.Active);
+        return;
       }
-      return color;
-    } /* End of 'Trace' function */
+
+      Packed.Intersect(P);
+      Accel.Intersect(P,
+        [&]( INT Prim, UINT Mask )
+        {
+          Bounded[Prim]->IntersectPacket(P, Mask);
+        });
+      for (auto Sh : Unbounded)
+        Sh->IntersectPacket(P, P.Active);
+    } /* End of 'Intersection' function */
 
     /* Is ray crossing with all shapes in scene function.
+     * Traversal keeps only the slim hit record, attributes of the
+     * closest hit are resolved by caller ('intr' constructor).
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer:
+     *      hit *H;
      * RETURNS:
      *   (BOOL) Is intersection with shapes.
      */
-    BOOL Intersection( const ray &R, intr *Intr )
+    BOOL Intersection( const ray &R, hit *H )
     {
-      intr intrsec;
+      H->T = HUGE_VAL;
 
-      Intr->T = HUGE_VAL;
+      // No hierarchy yet - check all shapes
+      if (!IsAccelValid)
+      {
+        for (auto Sh : Shapes)
+          Sh->Intersect(R, H);
+      }
+      else
+      {
+        Packed.Intersect(R, H->T, &H->Sh, &H->Prim);
+        Accel.Intersect(R, H->T,
+          [&]( INT Prim, REAL &MaxT )
+          {
+            if (!Bounded[Prim]->Intersect(R, H))
+              return FALSE;
+            MaxT = H->T;
+            return TRUE;
+          });
 
-      for (auto Sh : Shapes)
-        if (Sh->Intersect(R, &intrsec))
-          if (intrsec.T < Intr->T)
-            *Intr = intrsec;
+        for (auto Sh : Unbounded)
+          Sh->Intersect(R, H);
+      }
 
-      if (Intr->T == HUGE_VAL)
+      if (H->T == HUGE_VAL)
         return FALSE;
       return TRUE;
     } /* End of 'Intersection' function */
+
+    /* Is ray segment blocked by any shape in scene function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if any shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT )
+    {
+      GORT_STAT_TIMER(SHADOW_TIME);
+      BOOL IsBlocked = Blocked(R, MaxT);
+
+      RayCounter++;
+      GORT_STAT_INC(SHADOW_RAYS);
+      if (IsBlocked)
+        GORT_STAT_INC(SHADOW_BLOCKED);
+      return IsBlocked;
+    } /* End of 'Occluded' function */
+
+    /* Are packet ray segments blocked by any shape in scene function.
+     * Coherent lanes are traced together with hit distances limited by
+     * segment lengths, found blockers are confirmed by scalar test and
+     * lanes not confirmed (or incoherent packet) are tested one by one.
+     * ARGUMENTS:
+     *   - rays from points (hit data of lanes is changed):
+     *      packet &P;
+     *   - lanes segment lengths:
+     *      const REAL *MaxT;
+     * RETURNS:
+     *   (UINT) blocked lanes mask.
+     */
+    UINT Occluded( packet &P, const REAL *MaxT )
+    {
+      if (P.Active == 0)
+        return 0;
+
+      GORT_STAT_TIMER(SHADOW_TIME);
+      UINT Mask = 0;
+      BOOL IsPacket = P.IsCoherent();
+
+      if (IsPacket)
+      {
+        for (INT i = 0; i < PacketSize; i++)
+          if (P.Active & (1u << i))
+            P.T[i] = MaxT[i];
+        Intersection(P);
+      }
+      for (INT i = 0; i < PacketSize; i++)
+        if (P.Active & (1u << i))
+        {
+          ray R = P.Get(i);
+
+          if (IsPacket)
+          {
+            // packet miss is trusted like for camera rays, found blocker is confirmed by its shape only
+            if (P.Sh[i] == nullptr)
+              continue;
+            if (P.Sh[i]->Occluded(R, MaxT[i]))
+            {
+              Mask |= 1u << i;
+              continue;
+            }
+          }
+          // incoherent packet or blocker not confirmed by scalar test (other shape may still block)
+          if (Blocked(R, MaxT[i]))
+            Mask |= 1u << i;
+        }
+
+      INT Count = P.GetCount();
+
+      RayCounter += Count;
+      GORT_STAT_ADD(SHADOW_RAYS, Count);
+      for (UINT m = Mask; m != 0; m &= m - 1)
+        GORT_STAT_INC(SHADOW_BLOCKED);
+      return Mask;
+    } /* End of 'Occluded' function */
+
+    /* Is ray segment blocked by any shape in scene (without counting) function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if any shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Blocked( const ray &R, REAL MaxT )
+    {
+      if (!IsAccelValid)
+      {
+        for (auto Sh : Shapes)
+          if (Sh->Occluded(R, MaxT))
+            return TRUE;
+        return FALSE;
+      }
+
+      if (Packed.Occluded(R, MaxT))
+        return TRUE;
+      for (auto Sh : Unbounded)
+        if (Sh->Occluded(R, MaxT))
+          return TRUE;
+
+      return Accel.Occluded(R, MaxT,
+        [&]( INT Prim )
+        {
+          return Bounded[Prim]->Occluded(R, MaxT);
+        });
+    } /* End of 'Blocked' function */
+
     /*    ????????
     BOOL Intersection( const ray &R, intr *Intr )
     {
@@ -332,6 +1326,8 @@ namespace gort
     scene & operator<<( shape *Shape )
     {
       Shapes.push_back(Shape);
+      IsAccelValid = FALSE;
+      Version++;
 
       return *this;
     } /* End of '<<' function */
@@ -346,6 +1342,24 @@ namespace gort
     scene & operator<<( light *Light )
     {
       Lights.push_back(Light);
+      IsLightsValid = FALSE;
+      Version++;
+
+      return *this;
+    } /* End of '<<' function */
+
+    /* Add texture to scene operator.
+     * Scene owns textures of its materials.
+     * ARGUMENTS:
+     *   - texture pointer:
+     *       texture *Texture;
+     * RETURNS:
+     *   (scene &) Self-reference.
+     */
+    scene & operator<<( texture *Texture )
+    {
+      Textures.push_back(Texture);
+      Version++;
 
       return *this;
     } /* End of '<<' function */
@@ -0,0 +1,757 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scene_file.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Scene description files implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include "../models/models.h"
+#include "scene_file.h"
+
+/* Scene file commands */
+enum class scene_cmd : DWORD
+{
+  CAMERA, SURFACE, USE, ENVI, SPHERE, BOX, TRIANGLE, PLANE, POINT, SPOT, DIRECTION, MODEL, SPHERE_LIGHT, RECT_LIGHT,
+  MAP, CHECKER
+};
+
+/* Scene file command description class */
+class scene_cmd_info
+{
+public:
+  const CHAR *Name;  // Text keyword
+  scene_cmd Cmd;     // Command
+  BOOL HasName;      // Command starts with name argument
+  INT MinArgs;       // Minimal numbers count
+  INT MaxArgs;       // Maximal numbers count
+}; /* End of 'scene_cmd_info' class */
+
+/* Maximal numbers in command */
+static const INT SceneMaxArgs = 17;
+
+/* Commands table (indexed by command) */
+static const scene_cmd_info SceneCommands[] =
+{
+  {"camera",    scene_cmd::CAMERA,    FALSE, 6, 9},
+  {"surface",   scene_cmd::SURFACE,   TRUE, 12, 12},
+  {"use",       scene_cmd::USE,       TRUE, 0, 0},
+  {"envi",      scene_cmd::ENVI,      FALSE, 2, 2},
+  {"sphere",    scene_cmd::SPHERE,    FALSE, 4, 4},
+  {"box",       scene_cmd::BOX,       FALSE, 6, 6},
+  {"triangle",  scene_cmd::TRIANGLE,  FALSE, 9, 9},
+  {"plane",     scene_cmd::PLANE,     FALSE, 6, 6},
+  {"point",     scene_cmd::POINT,     FALSE, 9, 9},
+  {"spot",      scene_cmd::SPOT,      FALSE, 14, 14},
+  {"direction", scene_cmd::DIRECTION, FALSE, 6, 6},
+  {"model",     scene_cmd::MODEL,     TRUE, 0, 0},
+  {"spherelight", scene_cmd::SPHERE_LIGHT, FALSE, 10, 11},
+  {"rectlight", scene_cmd::RECT_LIGHT, FALSE, 15, 16},
+  {"map",       scene_cmd::MAP,       TRUE, 0, 0},
+  {"checker",   scene_cmd::CHECKER,   FALSE, 7, 7},
+};
+
+/* Binary scene file header class */
+class scene_bin_header
+{
+public:
+  DWORD Sign;     // Signature ("GSCB")
+  DWORD Version;  // Format version
+}; /* End of 'scene_bin_header' class */
+
+/* Binary scene record header class.
+ * Record data follows header: doubles for numeric commands, material
+ * index for 'USE', file name bytes for 'MODEL' and 'MAP'. Data is padded to 8
+ * bytes, so the numbers of mapped file are read in place. */
+class scene_bin_record
+{
+public:
+  DWORD Cmd;   // Command
+  DWORD Size;  // Data size in bytes (without padding)
+}; /* End of 'scene_bin_record' class */
+
+static const DWORD SceneBinSign = 'G' | 'S' << 8 | 'C' << 16 | 'B' << 24;
+static const DWORD SceneBinVersion = 1;
+
+/* Read only memory mapped file class */
+class mapped_file
+{
+public:
+  const CHAR *Data = nullptr;  // File data
+  size_t Size = 0;             // File size in bytes
+
+private:
+  BOOL IsOpen = FALSE;         // File open flag
+#ifdef _WIN32
+  HANDLE hFile = INVALID_HANDLE_VALUE, hMap = nullptr;
+#else
+  INT Fd = -1;
+#endif /* _WIN32 */
+
+public:
+  /* Map file constructor.
+   * ARGUMENTS:
+   *   - file name:
+   *      const std::string &FileName;
+   */
+  mapped_file( const std::string &FileName )
+  {
+#ifdef _WIN32
+    LARGE_INTEGER FileSize;
+
+    if ((hFile = CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+           FILE_FLAG_SEQUENTIAL_SCAN, nullptr)) == INVALID_HANDLE_VALUE || !GetFileSizeEx(hFile, &FileSize))
+      return;
+    if ((Size = static_cast<size_t>(FileSize.QuadPart)) == 0)
+    {
+      Data = "";
+      IsOpen = TRUE;
+      return;
+    }
+    if ((hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr)) == nullptr)
+      return;
+    if ((Data = static_cast<const CHAR *>(MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0))) != nullptr)
+      IsOpen = TRUE;
+#else
+    struct stat St;
+    VOID *Mem;
+
+    if ((Fd = open(FileName.c_str(), O_RDONLY)) == -1 || fstat(Fd, &St) != 0)
+      return;
+    if ((Size = static_cast<size_t>(St.st_size)) == 0)
+    {
+      Data = "";
+      IsOpen = TRUE;
+      return;
+    }
+    if ((Mem = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Fd, 0)) == MAP_FAILED)
+      return;
+    madvise(Mem, Size, MADV_SEQUENTIAL);
+    Data = static_cast<const CHAR *>(Mem);
+    IsOpen = TRUE;
+#endif /* _WIN32 */
+  } /* End of 'mapped_file' function */
+
+  /* Unmap file destructor */
+  ~mapped_file( VOID )
+  {
+#ifdef _WIN32
+    if (hMap != nullptr)
+    {
+      if (Data != nullptr)
+        UnmapViewOfFile(Data);
+      CloseHandle(hMap);
+    }
+    if (hFile != INVALID_HANDLE_VALUE)
+      CloseHandle(hFile);
+#else
+    if (IsOpen && Size > 0)
+      munmap(const_cast<CHAR *>(Data), Size);
+    if (Fd != -1)
+      close(Fd);
+#endif /* _WIN32 */
+  } /* End of '~mapped_file' function */
+
+  mapped_file( const mapped_file & ) = delete;
+  mapped_file & operator=( const mapped_file & ) = delete;
+
+  /* Check if file is mapped function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (BOOL) TRUE if file data is available.
+   */
+  BOOL IsMapped( VOID ) const
+  {
+    return IsOpen;
+  } /* End of 'IsMapped' function */
+}; /* End of 'mapped_file' class */
+
+/* Text scene parser class.
+ * File is scanned in place, numbers are read by 'std::from_chars',
+ * the only allocations are material and model names. Parsed commands
+ * are passed to sink with material names replaced by indices, so the
+ * same sink type serves scene loading and binary conversion. */
+class scene_text_parser
+{
+private:
+  const CHAR *S, *End;                           // Current and end text positions
+  INT Line = 1;                                  // Current line number
+  INT MtlCount = 0;                              // Defined materials count
+  std::unordered_map<std::string, INT> Mtls;     // Material indices by name
+
+  /* Skip spaces (not line ends) function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID SkipSpaces( VOID )
+  {
+    while (S < End && (*S == ' ' || *S == '\t' || *S == '\r'))
+      S++;
+  } /* End of 'SkipSpaces' function */
+
+  /* Check end of line function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (BOOL) TRUE if no more tokens on line.
+   */
+  BOOL IsLineEnd( VOID ) const
+  {
+    return S >= End || *S == '\n' || *S == '#';
+  } /* End of 'IsLineEnd' function */
+
+  /* Read token function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::string) token (empty on line end).
+   */
+  std::string ReadToken( VOID )
+  {
+    const CHAR *Begin = S;
+
+    while (S < End && *S != ' ' && *S != '\t' && *S != '\r' && *S != '\n' && *S != '#')
+      S++;
+    return std::string(Begin, S);
+  } /* End of 'ReadToken' function */
+
+public:
+  /* Parser constructor.
+   * ARGUMENTS:
+   *   - text range:
+   *      const CHAR *Begin, *NewEnd;
+   */
+  scene_text_parser( const CHAR *Begin, const CHAR *NewEnd ) : S(Begin), End(NewEnd)
+  {
+  } /* End of 'scene_text_parser' function */
+
+  /* Parse text function.
+   * ARGUMENTS:
+   *   - command sink
+   *     (BOOL Sink( scene_cmd Cmd, const DBL *Args, INT N, const std::string &Name, std::string *Msg ),
+   *      'Args' is material index for 'USE'):
+   *      sink_func Sink;
+   *   - error message pointer (without file and line):
+   *      std::string *Msg;
+   * RETURNS:
+   *   (BOOL) TRUE if whole text is parsed.
+   */
+  template<typename sink_func>
+    BOOL Parse( sink_func Sink, std::string *Msg )
+    {
+      DBL Args[SceneMaxArgs];
+
+      while (TRUE)
+      {
+        SkipSpaces();
+        if (S < End && *S == '#')
+          while (S < End && *S != '\n')
+            S++;
+        if (S >= End)
+          return TRUE;
+        if (*S == '\n')
+        {
+          S++;
+          Line++;
+          continue;
+        }
+
+        // command keyword
+        const CHAR *Word = S;
+        const scene_cmd_info *Info = nullptr;
+
+        while (S < End && *S >= 'a' && *S <= 'z')
+          S++;
+        if (IsLineEnd() || *S == ' ' || *S == '\t' || *S == '\r')
+          for (auto &C : SceneCommands)
+            if (strlen(C.Name) == static_cast<size_t>(S - Word) && strncmp(C.Name, Word, S - Word) == 0)
+              Info = &C;
+        if (Info == nullptr)
+        {
+          *Msg = "unknown command '" + std::string(Word, S) + ReadToken() + "'";
+          return FALSE;
+        }
+
+        // name argument
+        std::string Name;
+
+        if (Info->HasName)
+        {
+          SkipSpaces();
+          if ((Name = ReadToken()).empty())
+          {
+            *Msg = std::string("'") + Info->Name + "' expects a name";
+            return FALSE;
+          }
+        }
+
+        // numbers
+        INT N = 0;
+
+        while (SkipSpaces(), !IsLineEnd())
+        {
+          if (N == Info->MaxArgs)
+          {
+            *Msg = std::string("too many numbers for '") + Info->Name + "'";
+            return FALSE;
+          }
+          if (*S == '+')
+            S++;
+
+          auto Res = std::from_chars(S, End, Args[N]);
+
+          if (Res.ec != std::errc() || (Res.ptr < End && *Res.ptr != ' ' && *Res.ptr != '\t' &&
+                *Res.ptr != '\r' && *Res.ptr != '\n' && *Res.ptr != '#'))
+          {
+            *Msg = "bad number '" + ReadToken() + "'";
+            return FALSE;
+          }
+          S = Res.ptr;
+          N++;
+        }
+        if (N < Info->MinArgs)
+        {
+          *Msg = std::string("'") + Info->Name + "' expects " + std::to_string(Info->MinArgs) + " numbers, got " +
+            std::to_string(N);
+          return FALSE;
+        }
+
+        // material names are replaced by indices
+        if (Info->Cmd == scene_cmd::SURFACE)
+          Mtls[Name] = MtlCount++;
+        else if (Info->Cmd == scene_cmd::USE)
+        {
+          auto It = Mtls.find(Name);
+
+          if (It == Mtls.end())
+          {
+            *Msg = "unknown surface '" + Name + "'";
+            return FALSE;
+          }
+          Args[0] = It->second;
+          N = 1;
+        }
+        if (!Sink(Info->Cmd, Args, N, Name, Msg))
+          return FALSE;
+      }
+    } /* End of 'Parse' function */
+
+  /* Obtain current line number function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (INT) line number.
+   */
+  INT GetLine( VOID ) const
+  {
+    return Line;
+  } /* End of 'GetLine' function */
+}; /* End of 'scene_text_parser' class */
+
+/* Scene builder from parsed commands class */
+class scene_builder
+{
+private:
+  gort::scene &Scene;                // Filled scene
+  gort::camera &Cam;                 // Placed camera
+  std::string Dir;                   // Scene file directory (for models)
+  std::vector<gort::surface> Mtls;   // Defined materials
+  gort::surface Mtl;                 // Current material
+  INT MtlNo = -1;                    // Current material index (-1 - default one)
+  std::unordered_map<std::string, gort::texture *> Maps;  // Loaded maps by file name
+  gort::envi Media {0, 0};           // Current media
+
+public:
+  /* Builder constructor.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      gort::scene &NewScene;
+   *   - camera to be placed:
+   *      gort::camera &NewCam;
+   *   - scene file name:
+   *      const std::string &FileName;
+   */
+  scene_builder( gort::scene &NewScene, gort::camera &NewCam, const std::string &FileName ) : Scene(NewScene), Cam(NewCam)
+  {
+    size_t Slash = FileName.find_last_of("/\\");
+
+    if (Slash != std::string::npos)
+      Dir = FileName.substr(0, Slash + 1);
+  } /* End of 'scene_builder' function */
+
+  /* Set current material map function.
+   * ARGUMENTS:
+   *   - texture (owned by scene):
+   *      gort::texture *Tex;
+   * RETURNS: None.
+   */
+  VOID SetMap( gort::texture *Tex )
+  {
+    Mtl.Map = Tex;
+    if (MtlNo >= 0)
+      Mtls[MtlNo].Map = Tex;
+  } /* End of 'SetMap' function */
+
+  /* Apply command function.
+   * ARGUMENTS:
+   *   - command:
+   *      scene_cmd Cmd;
+   *   - numbers (material index for 'USE'):
+   *      const DBL *A;
+   *      INT N;
+   *   - name argument:
+   *      const std::string &Name;
+   *   - error message pointer:
+   *      std::string *Msg;
+   * RETURNS:
+   *   (BOOL) TRUE if command is applied.
+   */
+  BOOL operator()( scene_cmd Cmd, const DBL *A, INT N, const std::string &Name, std::string *Msg )
+  {
+    using namespace gort;
+
+    auto V = [A]( INT i )
+    {
+      return vec3(A[i], A[i + 1], A[i + 2]);
+    };
+
+    switch (Cmd)
+    {
+    case scene_cmd::CAMERA:
+      // up vector is all or nothing
+      if (N != 6 && N != 9)
+      {
+        *Msg = "'camera' expects 6 or 9 numbers, got " + std::to_string(N);
+        return FALSE;
+      }
+      Cam.SetLocAtUp(V(0), V(3), N == 9 ? V(6) : vec3(0, 1, 0));
+      break;
+    case scene_cmd::SURFACE:
+      Mtl = surface(V(0), V(3), V(6), A[9], A[10], A[11]);
+      MtlNo = static_cast<INT>(Mtls.size());
+      Mtls.push_back(Mtl);
+      break;
+    case scene_cmd::USE:
+      if (!std::isfinite(A[0]) || A[0] != std::floor(A[0]) || A[0] < 0 || A[0] >= Mtls.size())
+      {
+        *Msg = "bad surface index";
+        return FALSE;
+      }
+      MtlNo = static_cast<INT>(A[0]);
+      Mtl = Mtls[MtlNo];
+      break;
+    case scene_cmd::ENVI:
+      Media = envi(A[0], A[1]);
+      break;
+    case scene_cmd::SPHERE:
+      Scene << new sphere(V(0), A[3], Mtl, Media);
+      break;
+    case scene_cmd::BOX:
+      {
+        box *B = new box(V(0), V(3));
+
+        B->Mtl = Mtl;
+        B->Media = Media;
+        Scene << B;
+      }
+      break;
+    case scene_cmd::TRIANGLE:
+      {
+        triangle *T = new triangle(V(0), V(3), V(6));
+
+        T->Mtl = Mtl;
+        T->Media = Media;
+        Scene << T;
+      }
+      break;
+    case scene_cmd::PLANE:
+      {
+        plane *P = new plane(V(0), V(3), Mtl);
+
+        P->Media = Media;
+        Scene << P;
+      }
+      break;
+    case scene_cmd::POINT:
+      Scene << new point(V(0), V(3), 1, 1, A[6], A[7], A[8]);
+      break;
+    case scene_cmd::SPOT:
+      Scene << new spot(V(0), V(3), V(6), A[9], A[10], A[11], A[12], A[13]);
+      break;
+    case scene_cmd::DIRECTION:
+      Scene << new direction(V(0), V(3));
+      break;
+    case scene_cmd::SPHERE_LIGHT:
+      Scene << new sphere_light(V(0), A[3], V(4), A[7], A[8], A[9], N > 10 ? static_cast<INT>(A[10]) : 16);
+      break;
+    case scene_cmd::RECT_LIGHT:
+      Scene << new rect_light(V(0), V(3), V(6), V(9), A[12], A[13], A[14], N > 15 ? static_cast<INT>(A[15]) : 16);
+      break;
+    case scene_cmd::MODEL:
+      {
+        std::string Path = Name[0] == '/' || Name[0] == '\\' || Name.find(':') != std::string::npos ? Name : Dir + Name;
+
+        if (!LoadModel(Scene, Path))
+        {
+          *Msg = "cannot load model '" + Path + "'";
+          return FALSE;
+        }
+      }
+      break;
+    case scene_cmd::MAP:
+      {
+        std::string Path = Name[0] == '/' || Name[0] == '\\' || Name.find(':') != std::string::npos ? Name : Dir + Name;
+        texture *&Tex = Maps[Path];
+
+        if (Tex == nullptr)
+        {
+          Tex = new texture;
+          if (!Tex->Load(Path))
+          {
+            delete Tex;
+            Tex = nullptr;
+            *Msg = "cannot load map '" + Path + "'";
+            return FALSE;
+          }
+          Scene << Tex;
+        }
+        SetMap(Tex);
+      }
+      break;
+    case scene_cmd::CHECKER:
+      {
+        texture *Tex = new texture;
+
+        Tex->Checker(256, max(static_cast<INT>(A[0]), 1), V(1), V(4));
+        Scene << Tex;
+        SetMap(Tex);
+      }
+      break;
+    default:
+      *Msg = "unknown command";
+      return FALSE;
+    }
+    return TRUE;
+  } /* End of 'operator()' function */
+}; /* End of 'scene_builder' class */
+
+/* Report error function.
+ * ARGUMENTS:
+ *   - error message pointer (may be nullptr):
+ *      std::string *Error;
+ *   - message:
+ *      const std::string &Msg;
+ * RETURNS:
+ *   (BOOL) FALSE.
+ */
+static BOOL SceneFileError( std::string *Error, const std::string &Msg )
+{
+  if (Error != nullptr)
+    *Error = Msg;
+  return FALSE;
+} /* End of 'SceneFileError' function */
+
+/* Parse mapped text scene file function.
+ * ARGUMENTS:
+ *   - scene file name:
+ *      const std::string &FileName;
+ *   - command sink:
+ *      sink_func Sink;
+ *   - error message pointer (may be nullptr):
+ *      std::string *Error;
+ * RETURNS:
+ *   (BOOL) TRUE if whole file is parsed.
+ */
+template<typename sink_func>
+  static BOOL ParseSceneText( const std::string &FileName, sink_func Sink, std::string *Error )
+  {
+    mapped_file F(FileName);
+
+    if (!F.IsMapped())
+      return SceneFileError(Error, "cannot open '" + FileName + "'");
+
+    scene_text_parser Parser(F.Data, F.Data + F.Size);
+    std::string Msg;
+
+    if (!Parser.Parse(Sink, &Msg))
+      return SceneFileError(Error, FileName + ":" + std::to_string(Parser.GetLine()) + ": " + Msg);
+    return TRUE;
+  } /* End of 'ParseSceneText' function */
+
+/* Load text scene file function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - camera to be placed:
+ *      camera &Cam;
+ *   - scene file name:
+ *      const std::string &FileName;
+ *   - error message pointer ('file:line: message', may be nullptr):
+ *      std::string *Error;
+ * RETURNS:
+ *   (BOOL) TRUE if scene loaded.
+ */
+BOOL gort::LoadSceneText( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error )
+{
+  scene_builder Builder(Scene, Cam, FileName);
+
+  return ParseSceneText(FileName,
+    [&]( scene_cmd Cmd, const DBL *A, INT N, const std::string &Name, std::string *Msg )
+    {
+      return Builder(Cmd, A, N, Name, Msg);
+    }, Error);
+} /* End of 'gort::LoadSceneText' function */
+
+/* Load binary scene file function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - camera to be placed:
+ *      camera &Cam;
+ *   - scene file name:
+ *      const std::string &FileName;
+ *   - error message pointer (may be nullptr):
+ *      std::string *Error;
+ * RETURNS:
+ *   (BOOL) TRUE if scene loaded.
+ */
+BOOL gort::LoadSceneBinary( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error )
+{
+  mapped_file F(FileName);
+
+  if (!F.IsMapped())
+    return SceneFileError(Error, "cannot open '" + FileName + "'");
+
+  const scene_bin_header *Header = reinterpret_cast<const scene_bin_header *>(F.Data);
+
+  if (F.Size < sizeof(scene_bin_header) || Header->Sign != SceneBinSign)
+    return SceneFileError(Error, FileName + ": not a binary scene file");
+  if (Header->Version != SceneBinVersion)
+    return SceneFileError(Error, FileName + ": unsupported version " + std::to_string(Header->Version));
+
+  scene_builder Builder(Scene, Cam, FileName);
+  size_t Pos = sizeof(scene_bin_header);
+  std::string Name, Msg;
+
+  while (Pos < F.Size)
+  {
+    const scene_bin_record *Rec = reinterpret_cast<const scene_bin_record *>(F.Data + Pos);
+    const CHAR *Data = F.Data + Pos + sizeof(scene_bin_record);
+
+    if (F.Size - Pos < sizeof(scene_bin_record))
+      return SceneFileError(Error, FileName + ": bad record at offset " + std::to_string(Pos));
+
+    size_t Padded = (static_cast<size_t>(Rec->Size) + 7) & ~static_cast<size_t>(7);
+
+    if (F.Size - Pos - sizeof(scene_bin_record) < Padded || Rec->Cmd >= sizeof(SceneCommands) / sizeof(SceneCommands[0]))
+      return SceneFileError(Error, FileName + ": bad record at offset " + std::to_string(Pos));
+
+    const scene_cmd_info &Info = SceneCommands[Rec->Cmd];
+    INT N = static_cast<INT>(Rec->Size / sizeof(DBL));
+
+    if (Info.Cmd == scene_cmd::MODEL || Info.Cmd == scene_cmd::MAP)
+      Name.assign(Data, Rec->Size), N = 0;
+    else if (Info.Cmd == scene_cmd::USE ? N != 1 : Rec->Size % sizeof(DBL) != 0 || N < Info.MinArgs || N > Info.MaxArgs)
+      return SceneFileError(Error, FileName + ": bad record at offset " + std::to_string(Pos));
+    if (!Builder(Info.Cmd, reinterpret_cast<const DBL *>(Data), N, Name, &Msg))
+      return SceneFileError(Error, FileName + ": record at offset " + std::to_string(Pos) + ": " + Msg);
+    Pos += sizeof(scene_bin_record) + Padded;
+  }
+  return TRUE;
+} /* End of 'gort::LoadSceneBinary' function */
+
+/* Load scene file by extension function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - camera to be placed:
+ *      camera &Cam;
+ *   - scene file name ('*.gsb' binary, text otherwise):
+ *      const std::string &FileName;
+ *   - error message pointer (may be nullptr):
+ *      std::string *Error;
+ * RETURNS:
+ *   (BOOL) TRUE if scene loaded.
+ */
+BOOL gort::LoadSceneFile( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error )
+{
+  if (FileName.size() > 4 && FileName.compare(FileName.size() - 4, 4, ".gsb") == 0)
+    return LoadSceneBinary(Scene, Cam, FileName, Error);
+  return LoadSceneText(Scene, Cam, FileName, Error);
+} /* End of 'gort::LoadSceneFile' function */
+
+/* Convert text scene file to binary one function.
+ * ARGUMENTS:
+ *   - text scene file name:
+ *      const std::string &TextFileName;
+ *   - binary scene file name:
+ *      const std::string &BinFileName;
+ *   - error message pointer (may be nullptr):
+ *      std::string *Error;
+ * RETURNS:
+ *   (BOOL) TRUE if scene converted.
+ */
+BOOL gort::ConvertSceneFile( const std::string &TextFileName, const std::string &BinFileName, std::string *Error )
+{
+  std::vector<BYTE> Out;
+  scene_bin_header Header {SceneBinSign, SceneBinVersion};
+
+  auto Put = [&Out]( const VOID *Data, size_t Size )
+  {
+    Out.insert(Out.end(), static_cast<const BYTE *>(Data), static_cast<const BYTE *>(Data) + Size);
+  };
+
+  Put(&Header, sizeof(Header));
+  if (!ParseSceneText(TextFileName,
+        [&]( scene_cmd Cmd, const DBL *A, INT N, const std::string &Name, std::string *Msg )
+        {
+          BOOL IsName = Cmd == scene_cmd::MODEL || Cmd == scene_cmd::MAP;
+          scene_bin_record Rec {static_cast<DWORD>(Cmd), static_cast<DWORD>(IsName ? Name.size() : N * sizeof(DBL))};
+
+          Put(&Rec, sizeof(Rec));
+          if (IsName)
+          {
+            Put(Name.data(), Name.size());
+            Out.resize((Out.size() + 7) & ~static_cast<size_t>(7));
+          }
+          else
+            Put(A, N * sizeof(DBL));
+          return TRUE;
+        }, Error))
+    return FALSE;
+
+  FILE *F = fopen(BinFileName.c_str(), "wb");
+
+  if (F == nullptr)
+    return SceneFileError(Error, "cannot create '" + BinFileName + "'");
+
+  BOOL IsOk = fwrite(Out.data(), 1, Out.size(), F) == Out.size();
+
+  fclose(F);
+  if (!IsOk)
+    return SceneFileError(Error, "cannot write '" + BinFileName + "'");
+  return TRUE;
+} /* End of 'gort::ConvertSceneFile' function */
+
+/* END OF 'scene_file.cpp' FILE */
@@ -0,0 +1,113 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scene_file.h
+ * PURPOSE     : Ray tracing project.
+ *               Scene description files handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __scene_file_h_
+#define __scene_file_h_
+
+#include <string>
+
+#include "../rt.h"
+
+/* Text scene format ('*.gsc'): one command per line, numbers are
+ * separated by spaces, '#' starts a comment:
+ *   camera    Loc(3) At(3) [Up(3)]
+ *   surface   Name Ka(3) Kd(3) Ks(3) Ph Kr Kt  - define and use material
+ *   use       Name                             - use defined material
+ *   envi      RefractionCoef DecayCoef         - media of next shapes
+ *   sphere    Center(3) Radius
+ *   box       Min(3) Max(3)
+ *   triangle  P0(3) P1(3) P2(3)
+ *   plane     Normal(3) Point(3)
+ *   point     Pos(3) Color(3) Cc Cl Cq
+ *   spot      Pos(3) Dir(3) Color(3) InnerAngle OuterAngle Cc Cl Cq
+ *   direction Dir(3) Color(3)
+ *   spherelight Center(3) Radius Color(3) Cc Cl Cq [Samples]
+ *   rectlight Corner(3) Edge1(3) Edge2(3) Color(3) Cc Cl Cq [Samples]
+ *                                              - lit side is 'Edge1 % Edge2'
+ *   model     FileName                         - OBJ or G3DM (own materials),
+ *                                                relative to scene file
+ *   map       FileName                         - ambient and diffuse map of current
+ *                                                material (TGA or PPM P6)
+ *   checker   Cells Color1(3) Color2(3)        - checker map of current material
+ * Binary scene format ('*.gsb') keeps the same commands as records
+ * of doubles (materials are referenced by index) and is loaded from
+ * memory mapped file without parsing. */
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Load text scene file function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - camera to be placed:
+   *      camera &Cam;
+   *   - scene file name:
+   *      const std::string &FileName;
+   *   - error message pointer ('file:line: message', may be nullptr):
+   *      std::string *Error;
+   * RETURNS:
+   *   (BOOL) TRUE if scene loaded.
+   */
+  BOOL LoadSceneText( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error = nullptr );
+
+  /* Load binary scene file function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - camera to be placed:
+   *      camera &Cam;
+   *   - scene file name:
+   *      const std::string &FileName;
+   *   - error message pointer (may be nullptr):
+   *      std::string *Error;
+   * RETURNS:
+   *   (BOOL) TRUE if scene loaded.
+   */
+  BOOL LoadSceneBinary( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error = nullptr );
+
+  /* Load scene file by extension function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - camera to be placed:
+   *      camera &Cam;
+   *   - scene file name ('*.gsb' binary, text otherwise):
+   *      const std::string &FileName;
+   *   - error message pointer (may be nullptr):
+   *      std::string *Error;
+   * RETURNS:
+   *   (BOOL) TRUE if scene loaded.
+   */
+  BOOL LoadSceneFile( scene &Scene, camera &Cam, const std::string &FileName, std::string *Error = nullptr );
+
+  /* Convert text scene file to binary one function.
+   * ARGUMENTS:
+   *   - text scene file name:
+   *      const std::string &TextFileName;
+   *   - binary scene file name:
+   *      const std::string &BinFileName;
+   *   - error message pointer (may be nullptr):
+   *      std::string *Error;
+   * RETURNS:
+   *   (BOOL) TRUE if scene converted.
+   */
+  BOOL ConvertSceneFile( const std::string &TextFileName, const std::string &BinFileName, std::string *Error = nullptr );
+} /* end of 'gort' namespace */
+
+#endif /* __scene_file_h_ */
+
+/* END OF 'scene_file.h' FILE */
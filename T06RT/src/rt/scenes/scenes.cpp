@@ -0,0 +1,337 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scenes.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Built-in scenes implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <utility>
+
+#include "scenes.h"
+
+/* Build torus mesh function.
+ * ARGUMENTS:
+ *   - torus center:
+ *      const vec3 &C;
+ *   - big and small radiuses:
+ *      REAL R, r;
+ *   - segments count along big and small circles:
+ *      INT N, M;
+ *   - torus material:
+ *      const surface &Mtl;
+ * RETURNS:
+ *   (mesh *) torus mesh with smooth normals.
+ */
+static gort::mesh * MakeTorus( const gort::vec3 &C, gort::REAL R, gort::REAL r, INT N, INT M, const gort::surface &Mtl )
+{
+  std::vector<gort::vec3> V, Nrm;
+  std::vector<INT> Ind;
+
+  V.reserve(N * M);
+  Nrm.reserve(N * M);
+  Ind.reserve(N * M * 6);
+  for (INT i = 0; i < N; i++)
+    for (INT j = 0; j < M; j++)
+    {
+      DBL
+        phi = 2 * mth::PI * i / N, theta = 2 * mth::PI * j / M;
+      gort::vec3
+        Dir(cos(phi), 0, sin(phi)),
+        n = Dir * cos(theta) + gort::vec3(0, sin(theta), 0);
+
+      V.push_back(C + Dir * R + n * r);
+      Nrm.push_back(n);
+    }
+  // vertices of neighbour segments are shared, so surface is closed
+  for (INT i = 0; i < N; i++)
+    for (INT j = 0; j < M; j++)
+    {
+      INT
+        p0 = i * M + j, p1 = (i + 1) % N * M + j,
+        p2 = (i + 1) % N * M + (j + 1) % M, p3 = i * M + (j + 1) % M;
+
+      Ind.insert(Ind.end(), {p0, p1, p2, p0, p2, p3});
+    }
+  return new gort::mesh(std::move(V), std::move(Ind), Mtl, std::move(Nrm));
+} /* End of 'MakeTorus' function */
+
+/* Fill scene with built-in scene function.
+ * ARGUMENTS:
+ *   - scene to be filled:
+ *      scene &Scene;
+ *   - camera to be placed:
+ *      camera &Cam;
+ *   - scene name ("default", "spheres", "lights", "manylights", "spots", "mesh", "forest", "shapes", "glass", "area",
+ *     "textured"):
+ *      const std::string &Name;
+ * RETURNS:
+ *   (BOOL) TRUE if scene name is known.
+ */
+BOOL gort::LoadScene( scene &Scene, camera &Cam, const std::string &Name )
+{
+  surface Mtl(vec3(0.4, 0.2, 0.8), vec3(0.3, 0.1, 0.89), vec3(0.4, 0.2, 0.9), 1, 0.4, 0.9);
+  surface Mtl1(vec3(0.1), vec3(0.8), vec3(0.2), 1, 0.9, 0.1);
+
+  if (Name == "default")
+  {
+    // Window application scene
+    Scene
+      << new sphere(vec3(0), 1, Mtl, envi(1, 0))
+      << new sphere(vec3(-0.2, 0, -2), 1, Mtl1, envi(1, 0))
+      << new plane(vec3(0, 1, 0), vec3(0, -1, 0), Mtl)
+      << new point(vec3(1, 7, 2), vec3(0.5, 0, 1), 1, 20, 0, 0.1, 0);
+    return TRUE;
+  }
+  if (Name == "spheres")
+  {
+    // Many small spheres grid
+    surface Gold(vec3(0.25, 0.148, 0.06475), vec3(0.4, 0.2368, 0.1036), vec3(0.774597, 0.458561, 0.200621), 76.8, 0.4, 0);
+
+    for (INT i = -16; i < 16; i++)
+      for (INT j = -16; j < 16; j++)
+        Scene << new sphere(vec3(i * 0.5, 0, j * 0.5), 0.2, (i + j) & 1 ? Gold : Mtl1);
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, -0.2, 0), Mtl1)
+      << new point(vec3(2, 10, 4), vec3(1), 1, 30, 0.5, 0.05, 0);
+    Cam.SetLocAtUp(vec3(0, 6, 10), vec3(0));
+    return TRUE;
+  }
+  if (Name == "lights")
+  {
+    // Lights grid over two matte spheres (direct lighting only)
+    surface Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0, 0);
+
+    Scene
+      << new sphere(vec3(0), 1, Matte)
+      << new sphere(vec3(-0.2, 0, -2), 1, Matte)
+      << new plane(vec3(0, 1, 0), vec3(0, -1, 0), Matte);
+    for (INT i = -2; i < 3; i++)
+      for (INT j = -2; j < 3; j++)
+        Scene << new point(vec3(j * 3, 7, i * 3), vec3(1), 10, 20, 1, 0.3, 0.1);
+    Cam.SetLocAtUp(vec3(0, 3, 8), vec3(0));
+    return TRUE;
+  }
+  if (Name == "manylights")
+  {
+    // 1024 colored short range lights over spheres grid (direct lighting only)
+    surface Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0, 0);
+
+    Scene << new plane(vec3(0, 1, 0), vec3(0, -0.3, 0), Matte);
+    for (INT i = -8; i < 8; i++)
+      for (INT j = -8; j < 8; j++)
+        Scene << new sphere(vec3(j * 2 + 1, 0, i * 2 + 1), 0.3, Matte);
+    for (INT i = -16; i < 16; i++)
+      for (INT j = -16; j < 16; j++)
+      {
+        vec3 Color(0.5 + 0.5 * sin(i * 0.7), 0.5 + 0.5 * sin(j * 0.9 + 2), 0.5 + 0.5 * sin((i + j) * 0.5 + 4));
+
+        Scene << new point(vec3(j + 0.5, 0.6, i + 0.5), Color * 3, 1, 20, 1, 0, 25);
+      }
+    Cam.SetLocAtUp(vec3(0, 12, 18), vec3(0));
+    return TRUE;
+  }
+  if (Name == "spots")
+  {
+    // Colored spot lights circle around the spheres grid with dim sky light
+    surface Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0, 0);
+
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, -0.3, 0), Matte)
+      << new direction(vec3(-1, -3, -2), vec3(0.15, 0.15, 0.2));
+    for (INT i = -8; i < 8; i++)
+      for (INT j = -8; j < 8; j++)
+        Scene << new sphere(vec3(j * 2 + 1, 0, i * 2 + 1), 0.3, Matte);
+    for (INT i = 0; i < 64; i++)
+    {
+      REAL
+        a = i * 2 * mth::PI / 64,
+        r = 4 + 10 * (i % 4) / 3.0;
+      vec3
+        Pos(r * cos(a), 5, r * sin(a)),
+        Color(0.5 + 0.5 * sin(i * 0.7), 0.5 + 0.5 * sin(i * 0.9 + 2), 0.5 + 0.5 * sin(i * 0.5 + 4));
+
+      Scene << new spot(Pos, vec3(0, -1, 0), Color * 2, 10, 14, 1, 0.05, 0.01);
+    }
+    Cam.SetLocAtUp(vec3(0, 12, 18), vec3(0));
+    return TRUE;
+  }
+  if (Name == "mesh")
+  {
+    // Finely tessellated torus (256K triangles) over the floor
+    surface Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0.2, 0);
+
+    Scene
+      << MakeTorus(vec3(0, 0.5, 0), 2, 0.7, 512, 256, Matte)
+      << new plane(vec3(0, 1, 0), vec3(0, -1, 0), Mtl1)
+      << new point(vec3(2, 8, 4), vec3(1), 1, 30, 0.5, 0.05, 0);
+    Cam.SetLocAtUp(vec3(0, 5, 8), vec3(0));
+    return TRUE;
+  }
+  if (Name == "forest")
+  {
+    // 10000 instances of one 256K triangles torus over the floor
+    surface
+      Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0, 0),
+      Green(vec3(0.02, 0.05, 0.02), vec3(0.2, 0.6, 0.25), vec3(0.3), 16, 0, 0);
+    std::shared_ptr<shape> Torus(MakeTorus(vec3(0), 2, 0.7, 512, 256, Matte));
+
+    for (INT i = 0; i < 100; i++)
+      for (INT j = 0; j < 100; j++)
+      {
+        REAL
+          s = 0.2 + 0.1 * (0.5 + 0.5 * sin(i * 12.9898 + j * 78.233)),
+          a = 360 * (0.5 + 0.5 * sin(i * 39.346 + j * 11.135)),
+          b = 30 * sin(i * 73.156 + j * 52.235);
+        matr M =
+          matr::Scale(vec3(s)) * matr::RotateX(b) * matr::RotateY(a) *
+          matr::Translate(vec3((j - 50) * 2.0, 0.7 * s, (i - 50) * 2.0));
+
+        Scene << new instance(Torus, M, (i + j) % 3 ? Green : Matte);
+      }
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, 0, 0), Mtl1)
+      << new point(vec3(20, 40, 30), vec3(1), 1, 30, 1, 0, 0)
+      << new direction(vec3(1, -2, -1), vec3(0.3, 0.3, 0.35));
+    Cam.SetLocAtUp(vec3(0, 6, 30), vec3(0, 0, 0));
+    return TRUE;
+  }
+  if (Name == "shapes")
+  {
+    // Many small spheres, boxes and triangles (simple shapes storage test)
+    surface
+      Matte(vec3(0.05), vec3(0.7), vec3(0.3), 16, 0, 0),
+      Shiny(vec3(0.1), vec3(0.5, 0.3, 0.2), vec3(0.6), 32, 0.3, 0);
+
+    for (INT i = -40; i < 40; i++)
+      for (INT j = -40; j < 40; j++)
+      {
+        vec3 C(i * 0.25, 0, j * 0.25);
+        const surface &M = (i + j) & 1 ? Shiny : Matte;
+
+        switch ((i * 7 + j * 3) & 3)
+        {
+        case 0:
+          Scene << new sphere(C, 0.1, M);
+          break;
+        case 1:
+          {
+            box *B = new box(C - vec3(0.08, 0.1, 0.08), C + vec3(0.08, 0.1, 0.08));
+
+            B->Mtl = M;
+            Scene << B;
+          }
+          break;
+        default:
+          {
+            triangle *T = new triangle(C + vec3(-0.1, -0.1, 0), C + vec3(0.1, -0.1, 0), C + vec3(0, 0.12, 0.05));
+
+            T->Mtl = M;
+            Scene << T;
+          }
+          break;
+        }
+      }
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, -0.1, 0), Matte)
+      << new point(vec3(2, 10, 4), vec3(1), 1, 30, 0.5, 0.05, 0);
+    Cam.SetLocAtUp(vec3(0, 4, 7), vec3(0));
+    return TRUE;
+  }
+  if (Name == "glass")
+  {
+    // Nested glass spheres between two mirrors (deep refraction paths)
+    surface
+      Glass(vec3(0), vec3(0.05), vec3(0.8), 64, 0.15, 0.85),
+      Mirror(vec3(0.02), vec3(0.1), vec3(0.5), 32, 0.85, 0),
+      Matte(vec3(0.05), vec3(0.6), vec3(0.2), 8, 0, 0);
+
+    for (INT i = -2; i <= 2; i++)
+    {
+      vec3 C(i * 1.1, 0, 0);
+
+      Scene
+        << new sphere(C, 0.5, Glass, envi(1.5, 0.05))
+        << new sphere(C, 0.3, Glass, envi(1.33, 0.1))
+        << new sphere(C, 0.15, Glass, envi(1.9, 0));
+    }
+    Scene
+      << new plane(vec3(0, 0, 1), vec3(0, 0, -1.5), Mirror)
+      << new plane(vec3(0, 0, -1), vec3(0, 0, 6), Mirror)
+      << new plane(vec3(0, 1, 0), vec3(0, -0.5, 0), Matte)
+      << new point(vec3(1, 4, 3), vec3(1), 1, 20, 1, 0.05, 0)
+      << new point(vec3(-3, 2, -1), vec3(0.4, 0.5, 0.8), 1, 20, 1, 0.1, 0);
+    Scene.SetMaxRecLevel(16);
+    Cam.SetLocAtUp(vec3(0.5, 1.2, 5), vec3(0, 0, 0));
+    return TRUE;
+  }
+  if (Name == "area")
+  {
+    // Shapes under rectangle and sphere lights (soft shadows)
+    surface
+      Matte(vec3(0.05), vec3(0.7), vec3(0.2), 16, 0, 0),
+      Blue(vec3(0.05, 0, 0), vec3(0.8, 0.2, 0.15), vec3(0.3), 32, 0.1, 0);
+
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, -1, 0), Matte)
+      << new sphere(vec3(-1.2, 0, 0), 1, Blue)
+      << new sphere(vec3(1.3, -0.4, 0.8), 0.6, Matte)
+      << new rect_light(vec3(-1, 4, -1), vec3(2, 0, 0), vec3(0, 0, 2), vec3(1), 1, 0.05, 0.02, 64)
+      << new sphere_light(vec3(4, 3, 3), 0.7, vec3(0.4, 0.45, 0.6), 1, 0.05, 0.02, 64);
+    {
+      box *B = new box(vec3(0.4, -1, -1.6), vec3(1.4, 0.6, -0.6));
+
+      B->Mtl = Matte;
+      Scene << B;
+    }
+    Cam.SetLocAtUp(vec3(0, 3, 7), vec3(0, -0.3, 0));
+    return TRUE;
+  }
+  if (Name == "textured")
+  {
+    // Checker maps on a floor going to horizon (mip levels) and on shapes seen in mirror
+    texture
+      *Floor = new texture,
+      *Ball = new texture,
+      *Crate = new texture;
+
+    Floor->Checker(256, 4, vec3(0.9), vec3(0.15));
+    Ball->Checker(256, 8, vec3(0.2, 0.4, 0.9), vec3(0.9, 0.9, 0.8));
+    Crate->Checker(64, 4, vec3(0.3, 0.6, 0.9), vec3(0.1, 0.3, 0.5));
+    Scene << Floor << Ball << Crate;
+
+    surface
+      Matte(vec3(0.1), vec3(0.8), vec3(0.1), 8, 0, 0),
+      Paint(vec3(0.1), vec3(0.8), vec3(0.5), 32, 0.1, 0),
+      Mirror(vec3(0.02), vec3(0.1), vec3(0.5), 32, 0.85, 0);
+
+    Matte.Map = Floor;
+    Paint.Map = Ball;
+    Scene
+      << new plane(vec3(0, 1, 0), vec3(0, -1, 0), Matte)
+      << new sphere(vec3(-1.2, 0, 0), 1, Paint)
+      << new sphere(vec3(2.5, 0.2, -2.5), 1.2, Mirror)
+      << new point(vec3(2, 6, 4), vec3(1), 1, 30, 1, 0.02, 0)
+      << new direction(vec3(-1, -2, -1), vec3(0.3));
+    {
+      box *B = new box(vec3(0.4, -1, -0.4), vec3(1.6, 0.2, 0.8));
+
+      B->Mtl = Paint;
+      B->Mtl.Map = Crate;
+      Scene << B;
+    }
+    Cam.SetLocAtUp(vec3(0, 1.5, 7), vec3(0, -0.5, 0));
+    return TRUE;
+  }
+  return FALSE;
+} /* End of 'LoadScene' function */
+
+/* END OF 'scenes.cpp' FILE */
@@ -0,0 +1,44 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scenes.h
+ * PURPOSE     : Ray tracing project.
+ *               Built-in scenes handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __scenes_h_
+#define __scenes_h_
+
+#include <string>
+
+#include "../rt.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Fill scene with built-in scene function.
+   * ARGUMENTS:
+   *   - scene to be filled:
+   *      scene &Scene;
+   *   - camera to be placed:
+   *      camera &Cam;
+   *   - scene name ("default", "spheres", "lights", "manylights", "spots", "mesh", "forest", "shapes", "glass", "area",
+   *     "textured"):
+   *      const std::string &Name;
+   * RETURNS:
+   *   (BOOL) TRUE if scene name is known.
+   */
+  BOOL LoadScene( scene &Scene, camera &Cam, const std::string &Name );
+} /* end of 'gort' namespace */
+
+#endif /* __scenes_h_ */
+
+/* END OF 'scenes.h' FILE */
@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Box shape class functions implementation module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 02.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -20,22 +20,23 @@
  * ARGUMENTS:
  *   - ray from camera:
  *      const ray &R;
- *   - intersection data pointer:
- *      intr *Intr;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
  * RETURNS:
- *   (BOOL) Is intersection with box.
+ *   (BOOL) TRUE if box is crossed closer than 'H->T'.
  */
-BOOL gort::box::Intersect( const ray &R, intr *Intr )
+BOOL gort::box::Intersect( const ray &R, hit *H )
 {
+  GORT_STAT_INC(BOX_TESTS);
   INT Ind = 1, ind = 0;
-  DBL tnear = 0, tfar = HUGE_VAL;
+  REAL tnear = 0, tfar = HUGE_VAL;
 
   // X axis
   if (fabs(R.Dir[0]) < Threshold)
     if (R.Org[0] < MinBB[0] || R.Org[0] > MaxBB[0])
       return FALSE;
 
-  DBL
+  REAL
     t0 = (MinBB[0] - R.Org[0]) / R.Dir[0],
     t1 = (MaxBB[0] - R.Org[0]) / R.Dir[0];
 
@@ -101,14 +102,55 @@ BOOL gort::box::Intersect( const ray &R, intr *Intr )
   if (tfar < 0)
     return FALSE;
 
-  Intr->T = tnear;
-  Intr->P = R(tnear);
-  Intr->Sh = this;
-  Intr->I[0] = Ind;
+  if (tnear >= H->T)
+    return FALSE;
+  H->T = tnear;
+  H->Sh = this;
+  H->Prim = Ind;
   return TRUE;
 } /* End of 'Intersection' function */
 
+/* Is ray segment blocked by box function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if box is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::box::Occluded( const ray &R, REAL MaxT )
+{
+  GORT_STAT_INC(BOX_TESTS);
+  const REAL *mn = MinBB, *mx = MaxBB, *o = R.Org, *d = R.Dir;
+  REAL tnear = 0, tfar = HUGE_VAL;
+
+  for (INT i = 0; i < 3; i++)
+  {
+    if (fabs(d[i]) < Threshold)
+      if (o[i] < mn[i] || o[i] > mx[i])
+        return FALSE;
+
+    REAL
+      t0 = (mn[i] - o[i]) / d[i],
+      t1 = (mx[i] - o[i]) / d[i];
+
+    if (t0 > t1)
+      mth::Swap(t0, t1);
+    if (t0 > tnear)
+      tnear = t0;
+    if (t1 < tfar)
+      tfar = t1;
+
+    // the ray passes by box or box is behind ray
+    if (tnear > tfar || tfar < 0)
+      return FALSE;
+  }
+  return tnear >= Threshold && tnear < MaxT;
+} /* End of 'Occluded' function */
+
 /* Evaluate shape normal function.
+ * Texture covers every face once.
  * ARGUMENTS:
  *   - intersection data pointer:
  *      intr *Intr;
@@ -123,8 +165,73 @@ VOID gort::box::GetNormal( intr *Intr )
     vec3(0, 0, 1), vec3( 0,  0, -1),
   };
 
-  Intr->N = Normals[Intr->I[0]];
+  Intr->N = Normals[Intr->Prim];
+
+  INT
+    A = (Intr->Prim / 2 + 1) % 3,
+    B = (Intr->Prim / 2 + 2) % 3;
+  REAL
+    SA = MaxBB[A] - MinBB[A],
+    SB = MaxBB[B] - MinBB[B];
+
+  Intr->Tex = vec2((Intr->P[A] - MinBB[A]) / SA, (MaxBB[B] - Intr->P[B]) / SB);
+  Intr->TexScale = 1 / min(SA, SB);
 } /* End of 'GetNormal' funciton */
 
+/* Obtain shape bounding box function.
+ * ARGUMENTS:
+ *   - bounding box pointer:
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if shape is bounded.
+ */
+BOOL gort::box::GetBB( aabb *BB )
+{
+  *BB = aabb(MinBB, MaxBB);
+  return TRUE;
+} /* End of 'GetBB' funciton */
+
+/* Crossing rays packet with box function.
+ * ARGUMENTS:
+ *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+ *      packet &P;
+ *   - tested lanes mask:
+ *      UINT Mask;
+ * RETURNS: None.
+ */
+VOID gort::box::IntersectPacket( packet &P, UINT Mask )
+{
+  REAL tnear[PacketSize], tfar[PacketSize];
+  UINT Miss = 0, Hit = 0;
+
+  for (INT i = 0; i < PacketSize; i++)
+    tnear[i] = 0, tfar[i] = HUGE_VAL;
+  for (INT a = 0; a < 3; a++)
+  {
+    REAL mn = MinBB[a], mx = MaxBB[a];
+
+    for (INT i = 0; i < PacketSize; i++)
+    {
+      REAL
+        o = P.Org[a][i], d = P.Dir[a][i],
+        t0 = (mn - o) / d,
+        t1 = (mx - o) / d,
+        tmin = t0 < t1 ? t0 : t1,
+        tmax = t0 < t1 ? t1 : t0;
+
+      // parallel ray outside the slab
+      Miss |= (fabs(d) < Threshold && (o < mn || o > mx)) << i;
+      tnear[i] = tmin > tnear[i] ? tmin : tnear[i];
+      tfar[i] = tmax < tfar[i] ? tmax : tfar[i];
+    }
+  }
+  for (INT i = 0; i < PacketSize; i++)
+    Hit |= (tnear[i] <= tfar[i] && tfar[i] >= 0 && tnear[i] < P.T[i]) << i;
+
+  Hit &= Mask & ~Miss;
+  for (INT i = 0; i < PacketSize; i++)
+    if (Hit & (1u << i))
+      P.T[i] = tnear[i], P.Sh[i] = this;
+} /* End of 'IntersectPacket' function */
 
 /* END OF 'box.cpp' FILE */
\ No newline at end of file
@@ -26,6 +26,8 @@ namespace gort
   /* box class */
   class box : public shape
   {
+    friend class packed_shapes;
+
   private:
     vec3 MinBB; // box min vector
     vec3 MaxBB; // box max vector
@@ -34,12 +36,12 @@ namespace gort
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
      * RETURNS:
-     *   (BOOL) Is intersection with box.
+     *   (BOOL) TRUE if box is crossed closer than 'H->T'.
      */
-    BOOL Intersect( const ray &R, intr *Intr ) override;
+    BOOL Intersect( const ray &R, hit *H ) override;
 
     /* Evaluate shape normal function.
      * ARGUMENTS:
@@ -49,6 +51,36 @@ namespace gort
      */
     VOID GetNormal( intr *Intr ) override;
 
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is bounded.
+     */
+    BOOL GetBB( aabb *BB ) override;
+
+    /* Crossing rays packet with shape function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    VOID IntersectPacket( packet &P, UINT Mask ) override;
+
   public:
 
     /* Default constructor */
@@ -0,0 +1,127 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : instance.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Instanced shape class functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "instance.h"
+
+/* Instance class constructor.
+ * ARGUMENTS:
+ *   - shared geometry:
+ *     std::shared_ptr<shape> NewGeom;
+ *   - geometry to world transform:
+ *     const matr &M;
+ *   - instance material:
+ *     const surface &NewMtl;
+ */
+gort::instance::instance( std::shared_ptr<shape> NewGeom, const matr &M, const surface &NewMtl ) :
+  Geom(std::move(NewGeom)), InvM(M.Inverse()), TexScale(cbrt(fabs(InvM.Determ())))
+{
+  aabb GB;
+
+  Mtl = NewMtl;
+  // world box of transformed geometry box corners (infinite geometry leaves it empty)
+  if (Geom->GetBB(&GB))
+    for (INT i = 0; i < 8; i++)
+      Box.Grow(M.PointTransform(vec3(i & 1 ? GB.Max[0] : GB.Min[0],
+                                     i & 2 ? GB.Max[1] : GB.Min[1],
+                                     i & 4 ? GB.Max[2] : GB.Min[2])));
+} /* End of 'instance' function */
+
+/* Get crossing with instance function.
+ * Geometry space distance is the world one multiplied by the ray
+ * direction length in geometry space.
+ * ARGUMENTS:
+ *   - ray from camera:
+ *      const ray &R;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
+ * RETURNS:
+ *   (BOOL) TRUE if instance is crossed closer than 'H->T'.
+ */
+BOOL gort::instance::Intersect( const ray &R, hit *H )
+{
+  GORT_STAT_INC(INSTANCE_TESTS);
+  REAL Scale;
+  ray GR = ToGeom(R, &Scale);
+  hit h;
+
+  h.T = H->T * Scale;
+  if (!Geom->Intersect(GR, &h) || h.T / Scale >= H->T)
+    return FALSE;
+
+  H->T = h.T / Scale;
+  H->Sh = this;
+  H->Prim = h.Prim;
+  H->U = h.U;
+  H->V = h.V;
+  return TRUE;
+} /* End of 'Intersect' function */
+
+/* Evaluate shape normal function.
+ * Geometry normal is evaluated at geometry space point and is moved
+ * back by the transposed inverse transform, texture coordinates are
+ * the geometry ones.
+ * ARGUMENTS:
+ *   - intersection data pointer:
+ *      intr *Intr;
+ * RETURNS: None.
+ */
+VOID gort::instance::GetNormal( intr *Intr )
+{
+  intr in;
+
+  in.Sh = Geom.get();
+  in.Prim = Intr->Prim;
+  in.U = Intr->U;
+  in.V = Intr->V;
+  in.P = InvM.PointTransform(Intr->P);
+  Geom->GetNormal(&in);
+  Intr->N = InvM.TransposedVectorTransform(in.N).Normalizing();
+  Intr->Tex = in.Tex;
+  Intr->TexScale = in.TexScale * TexScale;
+} /* End of 'GetNormal' funciton */
+
+/* Is ray segment blocked by instance function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if instance is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::instance::Occluded( const ray &R, REAL MaxT )
+{
+  GORT_STAT_INC(INSTANCE_TESTS);
+  REAL Scale;
+  ray GR = ToGeom(R, &Scale);
+
+  return Geom->Occluded(GR, MaxT * Scale);
+} /* End of 'Occluded' function */
+
+/* Obtain shape bounding box function.
+ * ARGUMENTS:
+ *   - bounding box pointer:
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if geometry is bounded.
+ */
+BOOL gort::instance::GetBB( aabb *BB )
+{
+  *BB = Box;
+  return Box.Min[0] <= Box.Max[0];
+} /* End of 'GetBB' funciton */
+
+/* END OF 'instance.cpp' FILE */
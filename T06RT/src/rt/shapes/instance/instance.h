@@ -0,0 +1,125 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : instance.h
+ * PURPOSE     : Ray tracing project.
+ *               Instanced shape class handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __instance_h_
+#define __instance_h_
+
+#include <memory>
+
+#include "../../../def.h"
+#include "../../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Instanced shape class.
+   * Geometry (with its own hierarchy) is shared by all instances and is
+   * not added to scene itself, rays are moved to geometry space by the
+   * cached inverse transform. Hit data is the geometry one, instance
+   * gives its own material. */
+  class instance : public shape
+  {
+  private:
+    std::shared_ptr<shape> Geom;  // Shared geometry
+    matr InvM;                    // World to geometry space transform
+    REAL TexScale;                // Geometry space mean length of world unit (texture coordinates rate)
+    aabb Box;                     // World space bounding box
+
+    /* Obtain geometry space ray function.
+     * ARGUMENTS:
+     *   - world space ray:
+     *      const ray &R;
+     *   - world to geometry space distance scale pointer:
+     *      REAL *Scale;
+     * RETURNS:
+     *   (ray) geometry space ray.
+     */
+    ray ToGeom( const ray &R, REAL *Scale ) const
+    {
+      vec3 D = InvM.VectorTransform(R.Dir);
+
+      *Scale = !D;
+      return ray(InvM.PointTransform(R.Org), D);
+    } /* End of 'ToGeom' function */
+
+    /* Get crossing with instance function.
+     * ARGUMENTS:
+     *   - ray from camera:
+     *      const ray &R;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
+     * RETURNS:
+     *   (BOOL) TRUE if instance is crossed closer than 'H->T'.
+     */
+    BOOL Intersect( const ray &R, hit *H ) override;
+
+    /* Evaluate shape normal function.
+     * ARGUMENTS:
+     *   - intersection data pointer:
+     *      intr *Intr;
+     * RETURNS: None.
+     */
+    VOID GetNormal( intr *Intr ) override;
+
+    /* Is ray segment blocked by instance function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if instance is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if geometry is bounded.
+     */
+    BOOL GetBB( aabb *BB ) override;
+
+  public:
+    /* Instance class constructor.
+     * ARGUMENTS:
+     *   - shared geometry:
+     *     std::shared_ptr<shape> NewGeom;
+     *   - geometry to world transform:
+     *     const matr &M;
+     *   - instance material:
+     *     const surface &NewMtl;
+     */
+    instance( std::shared_ptr<shape> NewGeom, const matr &M, const surface &NewMtl );
+
+    /* Instance class constructor (geometry material).
+     * ARGUMENTS:
+     *   - shared geometry:
+     *     std::shared_ptr<shape> NewGeom;
+     *   - geometry to world transform:
+     *     const matr &M;
+     */
+    instance( std::shared_ptr<shape> NewGeom, const matr &M ) : instance(NewGeom, M, NewGeom->Mtl)
+    {
+      Media = Geom->Media;
+    } /* End of 'instance' function */
+  }; /* End of 'instance' class */
+} /* end of 'gort' namespace */
+
+#endif /* __instance_h_ */
+
+/* END OF 'instance.h' FILE */
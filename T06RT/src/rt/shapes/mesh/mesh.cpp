@@ -0,0 +1,304 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : mesh.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Indexed triangle mesh shape functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <utility>
+
+#include "mesh.h"
+
+/* Mesh class constructor.
+ * ARGUMENTS:
+ *   - vertex positions:
+ *     std::vector<vec3> NewV;
+ *   - triangles vertex indices (3 per triangle, triangles with bad indices are dropped):
+ *     std::vector<INT> NewInd;
+ *   - mesh material:
+ *     const surface &NewMtl;
+ *   - vertex normals (empty for flat shading):
+ *     std::vector<vec3> NewN;
+ *   - vertex texture coordinates (empty if not mapped):
+ *     std::vector<vec2> NewT;
+ */
+gort::mesh::mesh( std::vector<vec3> NewV, std::vector<INT> NewInd, const surface &NewMtl, std::vector<vec3> NewN,
+                  std::vector<vec2> NewT ) :
+  V(std::move(NewV)), N(std::move(NewN)), T(std::move(NewT)), Ind(std::move(NewInd))
+{
+  INT Count = 0, NumOfV = static_cast<INT>(V.size());
+
+  // triangles with indices out of vertex array are dropped
+  for (size_t i = 0; i + 2 < Ind.size(); i += 3)
+    if (Ind[i] >= 0 && Ind[i] < NumOfV && Ind[i + 1] >= 0 && Ind[i + 1] < NumOfV && Ind[i + 2] >= 0 && Ind[i + 2] < NumOfV)
+    {
+      Ind[Count * 3 + 0] = Ind[i];
+      Ind[Count * 3 + 1] = Ind[i + 1];
+      Ind[Count * 3 + 2] = Ind[i + 2];
+      Count++;
+    }
+  Ind.resize(Count * 3);
+
+  std::vector<aabb> Boxes(Count);
+
+  Mtl = NewMtl;
+  if (N.size() != V.size())
+    N.clear();
+  if (T.size() != V.size())
+    T.clear();
+  for (INT i = 0; i < Count; i++)
+  {
+    Boxes[i].Grow(V[Ind[i * 3 + 0]]);
+    Boxes[i].Grow(V[Ind[i * 3 + 1]]);
+    Boxes[i].Grow(V[Ind[i * 3 + 2]]);
+    Box.Grow(Boxes[i]);
+  }
+  Tree.Build(Boxes);
+} /* End of 'mesh' function */
+
+/* Shear ray class constructor.
+ * ARGUMENTS:
+ *   - ray to be prepared:
+ *      const ray &R;
+ */
+gort::mesh::shear_ray::shear_ray( const ray &R ) : Org(R.Org)
+{
+  // dominant axis becomes z, winding is kept by swapping x and y
+  Kz = fabs(R.Dir[0]) > fabs(R.Dir[1]) ?
+    (fabs(R.Dir[0]) > fabs(R.Dir[2]) ? 0 : 2) :
+    (fabs(R.Dir[1]) > fabs(R.Dir[2]) ? 1 : 2);
+  Kx = (Kz + 1) % 3;
+  Ky = (Kx + 1) % 3;
+  if (R.Dir[Kz] < 0)
+    mth::Swap(Kx, Ky);
+
+  Sx = R.Dir[Kx] / R.Dir[Kz];
+  Sy = R.Dir[Ky] / R.Dir[Kz];
+  Sz = 1 / R.Dir[Kz];
+} /* End of 'shear_ray' function */
+
+/* Watertight crossing with mesh triangle function.
+ * Ray is sheared to +z axis, so edge functions of neighbour triangles
+ * are evaluated with the same numbers and shared edges have no gaps.
+ * ARGUMENTS:
+ *   - prepared ray:
+ *      const shear_ray &R;
+ *   - triangle index:
+ *      INT Tri;
+ *   - maximal ray distance:
+ *      REAL MaxT;
+ *   - hit distance and barycentric coordinates pointers:
+ *      REAL *T, *B1, *B2;
+ * RETURNS:
+ *   (BOOL) TRUE if triangle is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::mesh::IntersectTri( const shear_ray &R, INT Tri, REAL MaxT, REAL *T, REAL *B1, REAL *B2 ) const
+{
+  GORT_STAT_INC(MESH_TESTS);
+  vec3
+    A = V[Ind[Tri * 3 + 0]] - R.Org,
+    B = V[Ind[Tri * 3 + 1]] - R.Org,
+    C = V[Ind[Tri * 3 + 2]] - R.Org;
+  REAL
+    Ax = A[R.Kx] - R.Sx * A[R.Kz], Ay = A[R.Ky] - R.Sy * A[R.Kz],
+    Bx = B[R.Kx] - R.Sx * B[R.Kz], By = B[R.Ky] - R.Sy * B[R.Kz],
+    Cx = C[R.Kx] - R.Sx * C[R.Kz], Cy = C[R.Ky] - R.Sy * C[R.Kz],
+    U = Cx * By - Cy * Bx,
+    W0 = Ax * Cy - Ay * Cx,
+    W1 = Bx * Ay - By * Ax;
+
+  // edge on the ray - recompute in double precision
+  if (U == 0 || W0 == 0 || W1 == 0)
+  {
+    U = static_cast<REAL>(static_cast<DBL>(Cx) * By - static_cast<DBL>(Cy) * Bx);
+    W0 = static_cast<REAL>(static_cast<DBL>(Ax) * Cy - static_cast<DBL>(Ay) * Cx);
+    W1 = static_cast<REAL>(static_cast<DBL>(Bx) * Ay - static_cast<DBL>(By) * Ax);
+  }
+
+  if ((U < 0 || W0 < 0 || W1 < 0) && (U > 0 || W0 > 0 || W1 > 0))
+    return FALSE;
+
+  REAL Det = U + W0 + W1;
+
+  if (Det == 0)
+    return FALSE;
+
+  REAL
+    t = U * R.Sz * A[R.Kz] + W0 * R.Sz * B[R.Kz] + W1 * R.Sz * C[R.Kz],
+    AbsDet = fabs(Det);
+
+  // compare unnormalized distance to avoid division for misses
+  if (Det < 0)
+    t = -t;
+  if (t < Threshold * AbsDet || t >= MaxT * AbsDet)
+    return FALSE;
+
+  *T = t / AbsDet;
+  *B1 = W0 / Det;
+  *B2 = W1 / Det;
+  return TRUE;
+} /* End of 'IntersectTri' function */
+
+/* Get crossing with mesh function.
+ * ARGUMENTS:
+ *   - ray from camera:
+ *      const ray &R;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
+ * RETURNS:
+ *   (BOOL) TRUE if mesh is crossed closer than 'H->T'.
+ */
+BOOL gort::mesh::Intersect( const ray &R, hit *H )
+{
+  shear_ray SR(R);
+  INT Best = -1;
+  REAL T = H->T, B1 = 0, B2 = 0;
+
+  // closer hit found by scene already bounds the traversal
+  Tree.Intersect(R, T,
+    [&]( INT Tri, REAL &MaxT )
+    {
+      REAL t, b1, b2;
+
+      if (!IntersectTri(SR, Tri, MaxT, &t, &b1, &b2))
+        return FALSE;
+      MaxT = T = t, Best = Tri, B1 = b1, B2 = b2;
+      return TRUE;
+    });
+
+  if (Best < 0)
+    return FALSE;
+
+  H->T = T;
+  H->Sh = this;
+  H->Prim = Best;
+  H->U = B1;
+  H->V = B2;
+  return TRUE;
+} /* End of 'Intersect' function */
+
+/* Is ray segment blocked by mesh function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if mesh is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::mesh::Occluded( const ray &R, REAL MaxT )
+{
+  shear_ray SR(R);
+
+  return Tree.Occluded(R, MaxT,
+    [&]( INT Tri )
+    {
+      REAL t, b1, b2;
+
+      return IntersectTri(SR, Tri, MaxT, &t, &b1, &b2);
+    });
+} /* End of 'Occluded' function */
+
+/* Evaluate shape normal function.
+ * Texture coordinates change rate is the ratio of triangle sizes in
+ * texture and in space.
+ * ARGUMENTS:
+ *   - intersection data pointer:
+ *      intr *Intr;
+ * RETURNS: None.
+ */
+VOID gort::mesh::GetNormal( intr *Intr )
+{
+  const INT *I = &Ind[Intr->Prim * 3];
+
+  if (!N.empty())
+    Intr->N = (N[I[0]] * (1 - Intr->U - Intr->V) + N[I[1]] * Intr->U + N[I[2]] * Intr->V).Normalizing();
+  else
+    Intr->N = ((V[I[1]] - V[I[0]]) % (V[I[2]] - V[I[0]])).Normalizing();
+
+  if (T.empty())
+    return;
+
+  vec2
+    T1 = T[I[1]] - T[I[0]],
+    T2 = T[I[2]] - T[I[0]];
+  REAL
+    TexArea = fabs(T1[0] * T2[1] - T1[1] * T2[0]),
+    Area = !((V[I[1]] - V[I[0]]) % (V[I[2]] - V[I[0]]));
+
+  Intr->Tex = T[I[0]] * (1 - Intr->U - Intr->V) + T[I[1]] * Intr->U + T[I[2]] * Intr->V;
+  Intr->TexScale = Area > 0 ? sqrt(TexArea / Area) : 0;
+} /* End of 'GetNormal' funciton */
+
+/* Obtain shape bounding box function.
+ * ARGUMENTS:
+ *   - bounding box pointer:
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if shape is bounded.
+ */
+BOOL gort::mesh::GetBB( aabb *BB )
+{
+  *BB = Box;
+  return GetTriCount() > 0;
+} /* End of 'GetBB' funciton */
+
+/* Crossing rays packet with mesh function.
+ * Lanes are tested against one triangle at a time by Moller-Trumbore
+ * test, exact hit is found by scalar test of the hit mesh later.
+ * ARGUMENTS:
+ *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+ *      packet &P;
+ *   - tested lanes mask:
+ *      UINT Mask;
+ * RETURNS: None.
+ */
+VOID gort::mesh::IntersectPacket( packet &P, UINT Mask )
+{
+  Tree.Intersect(P,
+    [&]( INT Tri, UINT Lanes )
+    {
+      const vec3
+        &P0 = V[Ind[Tri * 3 + 0]],
+        E1 = V[Ind[Tri * 3 + 1]] - P0,
+        E2 = V[Ind[Tri * 3 + 2]] - P0;
+      REAL t[PacketSize];
+      UINT Hit = 0;
+
+      for (INT i = 0; i < PacketSize; i++)
+      {
+        REAL
+          dx = P.Dir[0][i], dy = P.Dir[1][i], dz = P.Dir[2][i],
+          px = dy * E2[2] - dz * E2[1],
+          py = dz * E2[0] - dx * E2[2],
+          pz = dx * E2[1] - dy * E2[0],
+          Det = E1[0] * px + E1[1] * py + E1[2] * pz,
+          InvDet = 1 / Det,
+          sx = P.Org[0][i] - P0[0], sy = P.Org[1][i] - P0[1], sz = P.Org[2][i] - P0[2],
+          u = (sx * px + sy * py + sz * pz) * InvDet,
+          qx = sy * E1[2] - sz * E1[1],
+          qy = sz * E1[0] - sx * E1[2],
+          qz = sx * E1[1] - sy * E1[0],
+          v = (dx * qx + dy * qy + dz * qz) * InvDet;
+
+        t[i] = (E2[0] * qx + E2[1] * qy + E2[2] * qz) * InvDet;
+        Hit |= (Det != 0 && u >= 0 && v >= 0 && u + v <= 1 && t[i] >= Threshold && t[i] < P.T[i]) << i;
+      }
+
+      Hit &= Lanes & Mask;
+      for (INT i = 0; i < PacketSize; i++)
+        if (Hit & (1u << i))
+          P.T[i] = t[i], P.Sh[i] = this;
+    });
+} /* End of 'IntersectPacket' function */
+
+/* END OF 'mesh.cpp' FILE */
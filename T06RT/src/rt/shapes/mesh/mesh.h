@@ -0,0 +1,175 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : mesh.h
+ * PURPOSE     : Ray tracing project.
+ *               Indexed triangle mesh shape handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __mesh_h_
+#define __mesh_h_
+
+#include <vector>
+
+#include "../../../def.h"
+#include "../../rt_def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Triangle mesh class.
+   * Vertices are shared by triangles through index triples, triangles
+   * are found by the mesh own hierarchy. Hit data: 'Prim' - triangle
+   * index, 'U', 'V' - barycentric coordinates of the second and the
+   * third triangle vertices. */
+  class mesh : public shape
+  {
+  private:
+    std::vector<vec3> V;  // Vertex positions
+    std::vector<vec3> N;  // Vertex normals (empty for flat shading)
+    std::vector<vec2> T;  // Vertex texture coordinates (empty if not mapped)
+    std::vector<INT> Ind; // Triangles vertex indices (3 per triangle)
+    bvh Tree;             // Triangles hierarchy
+    aabb Box;             // Mesh bounding box
+
+    /* Watertight ray-triangle test ray data class */
+    class shear_ray
+    {
+    public:
+      vec3 Org;         // Ray origin
+      INT Kx, Ky, Kz;   // Axes permutation (Kz - dominant direction axis)
+      REAL Sx, Sy, Sz;  // Shear constants
+
+      /* Shear ray class constructor.
+       * ARGUMENTS:
+       *   - ray to be prepared:
+       *      const ray &R;
+       */
+      shear_ray( const ray &R );
+    }; /* End of 'shear_ray' class */
+
+    /* Watertight crossing with mesh triangle function.
+     * ARGUMENTS:
+     *   - prepared ray:
+     *      const shear_ray &R;
+     *   - triangle index:
+     *      INT Tri;
+     *   - maximal ray distance:
+     *      REAL MaxT;
+     *   - hit distance and barycentric coordinates pointers:
+     *      REAL *T, *B1, *B2;
+     * RETURNS:
+     *   (BOOL) TRUE if triangle is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL IntersectTri( const shear_ray &R, INT Tri, REAL MaxT, REAL *T, REAL *B1, REAL *B2 ) const;
+
+    /* Get crossing with mesh function.
+     * ARGUMENTS:
+     *   - ray from camera:
+     *      const ray &R;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
+     * RETURNS:
+     *   (BOOL) TRUE if mesh is crossed closer than 'H->T'.
+     */
+    BOOL Intersect( const ray &R, hit *H ) override;
+
+    /* Evaluate shape normal function.
+     * ARGUMENTS:
+     *   - intersection data pointer:
+     *      intr *Intr;
+     * RETURNS: None.
+     */
+    VOID GetNormal( intr *Intr ) override;
+
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is bounded.
+     */
+    BOOL GetBB( aabb *BB ) override;
+
+    /* Crossing rays packet with shape function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    VOID IntersectPacket( packet &P, UINT Mask ) override;
+
+  public:
+    /* Mesh class constructor.
+     * ARGUMENTS:
+     *   - vertex positions:
+     *     std::vector<vec3> NewV;
+     *   - triangles vertex indices (3 per triangle, triangles with bad indices are dropped):
+     *     std::vector<INT> NewInd;
+     *   - mesh material:
+     *     const surface &NewMtl;
+     *   - vertex normals (empty for flat shading):
+     *     std::vector<vec3> NewN;
+     *   - vertex texture coordinates (empty if not mapped):
+     *     std::vector<vec2> NewT;
+     */
+    mesh( std::vector<vec3> NewV, std::vector<INT> NewInd, const surface &NewMtl, std::vector<vec3> NewN = {},
+          std::vector<vec2> NewT = {} );
+
+    /* Obtain triangles count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) triangles count.
+     */
+    INT GetTriCount( VOID ) const
+    {
+      return static_cast<INT>(Ind.size() / 3);
+    } /* End of 'GetTriCount' function */
+
+    /* Obtain mesh memory size function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) bytes used by vertices, indices and hierarchy.
+     */
+    UINT64 GetMemorySize( VOID ) const
+    {
+      return V.capacity() * sizeof(vec3) + N.capacity() * sizeof(vec3) + T.capacity() * sizeof(vec2) +
+        Ind.capacity() * sizeof(INT) + Tree.GetNodeCount() * sizeof(bvh::node) + GetTriCount() * sizeof(INT);
+    } /* End of 'GetMemorySize' function */
+
+    /* Obtain mesh hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const bvh &) triangles hierarchy.
+     */
+    const bvh & GetTree( VOID ) const
+    {
+      return Tree;
+    } /* End of 'GetTree' function */
+  }; /* End of 'mesh' class */
+} /* end of 'gort' namespace */
+
+#endif /* __mesh_h_ */
+
+/* END OF 'mesh.h' FILE */
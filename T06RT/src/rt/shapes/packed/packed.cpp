@@ -0,0 +1,111 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : packed.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Packed (per type arrays) simple shapes storage functions implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <typeinfo>
+
+#include "../../rt.h"
+
+/* Add shape to storage function.
+ * Only exact shape types are packed, derived classes may change
+ * intersection, so they are left to virtual calls.
+ * ARGUMENTS:
+ *   - shape to be copied:
+ *      shape *Sh;
+ * RETURNS:
+ *   (BOOL) TRUE if shape type is packed.
+ */
+BOOL gort::packed_shapes::Add( shape *Sh )
+{
+  const std::type_info &Type = typeid(*Sh);
+  aabb BB;
+
+  if (Type == typeid(sphere))
+  {
+    sphere *S = static_cast<sphere *>(Sh);
+
+    S->GetBB(&BB);
+    AddBounded(SPHERE, Spheres.Add(S->C, S->R2), Sh, BB);
+    return TRUE;
+  }
+  if (Type == typeid(box))
+  {
+    box *B = static_cast<box *>(Sh);
+
+    B->GetBB(&BB);
+    AddBounded(BOX, Boxes.Add(B->MinBB, B->MaxBB), Sh, BB);
+    return TRUE;
+  }
+  if (Type == typeid(triangle))
+  {
+    triangle *T = static_cast<triangle *>(Sh);
+
+    T->GetBB(&BB);
+    AddBounded(TRIANGLE, Triangles.Add(T->N, T->D, T->U1, T->u0, T->V1, T->v0), Sh, BB);
+    return TRUE;
+  }
+  if (Type == typeid(plane))
+  {
+    plane *P = static_cast<plane *>(Sh);
+
+    Planes.Add(P->N, P->D);
+    PlaneOwners.push_back(Sh);
+    return TRUE;
+  }
+  return FALSE;
+} /* End of 'Add' function */
+
+/* Build storage function.
+ * Hierarchy leaves order becomes storage order: shapes of every type
+ * get type arrays indices in order of their leaves.
+ * ARGUMENTS:
+ *   - hierarchy build mode:
+ *      bvh::mode Mode;
+ *   - hierarchy subtree tasks pool (may be nullptr):
+ *      pool *Pool;
+ * RETURNS: None.
+ */
+VOID gort::packed_shapes::Build( bvh::mode Mode, pool *Pool )
+{
+  Tree.SetMode(Mode);
+  Tree.Build(Bounds, Pool);
+  Bounds.clear();
+  Bounds.shrink_to_fit();
+
+  // shapes of one type follow each other in leaf, so type switch is predictable
+  std::vector<INT>
+    Order = Tree.Renumber(
+      [&]( INT i )
+      {
+        return static_cast<INT>(Kinds[i]);
+      }),
+    TypeOrder[3];
+
+  gort::Permute(Kinds, Order);
+  gort::Permute(Index, Order);
+  gort::Permute(Owners, Order);
+  for (size_t i = 0; i < Kinds.size(); i++)
+  {
+    std::vector<INT> &TO = TypeOrder[Kinds[i]];
+
+    TO.push_back(Index[i]);
+    Index[i] = static_cast<INT>(TO.size()) - 1;
+  }
+  gort::Permute(Spheres.Items, TypeOrder[SPHERE]);
+  gort::Permute(Boxes.Items, TypeOrder[BOX]);
+  gort::Permute(Triangles.Items, TypeOrder[TRIANGLE]);
+} /* End of 'Build' function */
+
+/* END OF 'packed.cpp' FILE */
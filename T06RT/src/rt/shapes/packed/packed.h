@@ -0,0 +1,776 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : packed.h
+ * PURPOSE     : Ray tracing project.
+ *               Packed (per type arrays) simple shapes storage handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __packed_h_
+#define __packed_h_
+
+#include <cmath>
+#include <vector>
+
+#include "../../../def.h"
+#include "../../bvh/bvh.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  // Forward declaration
+  class shape;
+
+  /* Reorder array function.
+   * ARGUMENTS:
+   *   - array to be reordered:
+   *      std::vector<type> &A;
+   *   - old index of every new element:
+   *      const std::vector<INT> &Order;
+   * RETURNS: None.
+   */
+  template<typename type>
+    VOID Permute( std::vector<type> &A, const std::vector<INT> &Order )
+    {
+      std::vector<type> B(A.size());
+
+      for (size_t i = 0; i < Order.size(); i++)
+        B[i] = A[Order[i]];
+      A.swap(B);
+    } /* End of 'Permute' function */
+
+  /* Packed spheres class */
+  class packed_spheres
+  {
+  public:
+    /* Sphere record class */
+    class item
+    {
+    public:
+      REAL Cx, Cy, Cz, R2;  // Center and squared radius
+    }; /* End of 'item' class */
+
+    std::vector<item> Items;  // Spheres records
+
+    /* Add sphere function.
+     * ARGUMENTS:
+     *   - sphere center:
+     *      const vec3 &C;
+     *   - squared radius:
+     *      REAL R2;
+     * RETURNS:
+     *   (INT) sphere index.
+     */
+    INT Add( const vec3 &C, REAL R2 )
+    {
+      Items.push_back({C[0], C[1], C[2], R2});
+      return static_cast<INT>(Items.size()) - 1;
+    } /* End of 'Add' function */
+
+    /* Find sphere crossing function.
+     * ARGUMENTS:
+     *   - sphere index:
+     *      INT i;
+     *   - ray:
+     *      const ray &R;
+     *   - hit distance pointer:
+     *      REAL *T;
+     *   - crossed face pointer (unused):
+     *      INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if sphere is crossed (as 'sphere::Intersect').
+     */
+    BOOL Hit( INT i, const ray &R, REAL *T, INT *Face ) const
+    {
+      GORT_STAT_INC(SPHERE_TESTS);
+      const item &S = Items[i];
+      REAL
+        ax = S.Cx - R.Org[0], ay = S.Cy - R.Org[1], az = S.Cz - R.Org[2],
+        OC2 = ax * ax + ay * ay + az * az,
+        OK = ax * R.Dir[0] + ay * R.Dir[1] + az * R.Dir[2],
+        h2 = S.R2 - (OC2 - OK * OK);
+
+      // the ray starts inside the sphere
+      if (OC2 < S.R2)
+      {
+        *T = OK + sqrt(h2);
+        return TRUE;
+      }
+      // the ray leaves the sphere behind or passes by
+      if (OK < 0 || h2 < 0)
+        return FALSE;
+      *T = OK - sqrt(h2);
+      return TRUE;
+    } /* End of 'Hit' function */
+
+    /* Is ray segment blocked by sphere function.
+     * ARGUMENTS:
+     *   - sphere index:
+     *      INT i;
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if sphere is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Block( INT i, const ray &R, REAL MaxT ) const
+    {
+      REAL t;
+      INT f;
+
+      return Hit(i, R, &t, &f) && t >= Threshold && t < MaxT;
+    } /* End of 'Block' function */
+
+    /* Crossing rays packet with sphere function.
+     * ARGUMENTS:
+     *   - sphere index:
+     *      INT i;
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     *   - sphere shape:
+     *      shape *Sh;
+     * RETURNS: None.
+     */
+    VOID HitPacket( INT i, packet &P, UINT Mask, shape *Sh ) const
+    {
+      const item &S = Items[i];
+      REAL t[PacketSize];
+      UINT Hit = 0;
+
+      for (INT k = 0; k < PacketSize; k++)
+      {
+        REAL
+          ax = S.Cx - P.Org[0][k], ay = S.Cy - P.Org[1][k], az = S.Cz - P.Org[2][k],
+          OC2 = ax * ax + ay * ay + az * az,
+          OK = ax * P.Dir[0][k] + ay * P.Dir[1][k] + az * P.Dir[2][k],
+          h2 = S.R2 - (OC2 - OK * OK),
+          h = sqrt(h2 > 0 ? h2 : 0);
+        BOOL Inside = OC2 < S.R2;
+
+        t[k] = Inside ? OK + h : OK - h;
+        Hit |= ((Inside || (OK >= 0 && h2 >= 0)) && t[k] < P.T[k]) << k;
+      }
+
+      Hit &= Mask;
+      for (INT k = 0; k < PacketSize; k++)
+        if (Hit & (1u << k))
+          P.T[k] = t[k], P.Sh[k] = Sh;
+    } /* End of 'HitPacket' function */
+  }; /* End of 'packed_spheres' class */
+
+  /* Packed boxes class */
+  class packed_boxes
+  {
+  public:
+    /* Box record class */
+    class item
+    {
+    public:
+      REAL Min[3], Max[3];  // Box corners
+    }; /* End of 'item' class */
+
+    std::vector<item> Items;  // Boxes records
+
+    /* Add box function.
+     * ARGUMENTS:
+     *   - box corners:
+     *      const vec3 &Lo, &Hi;
+     * RETURNS:
+     *   (INT) box index.
+     */
+    INT Add( const vec3 &Lo, const vec3 &Hi )
+    {
+      Items.push_back({{Lo[0], Lo[1], Lo[2]}, {Hi[0], Hi[1], Hi[2]}});
+      return static_cast<INT>(Items.size()) - 1;
+    } /* End of 'Add' function */
+
+    /* Find box crossing function.
+     * ARGUMENTS:
+     *   - box index:
+     *      INT i;
+     *   - ray:
+     *      const ray &R;
+     *   - hit distance pointer:
+     *      REAL *T;
+     *   - crossed face pointer ('box::GetNormal' normal index):
+     *      INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if box is crossed (as 'box::Intersect').
+     */
+    BOOL Hit( INT i, const ray &R, REAL *T, INT *Face ) const
+    {
+      GORT_STAT_INC(BOX_TESTS);
+      const item &B = Items[i];
+      REAL tnear = 0, tfar = HUGE_VAL;
+      INT f = 1;
+
+      for (INT a = 0; a < 3; a++)
+      {
+        REAL o = R.Org[a], d = R.Dir[a];
+
+        // parallel ray outside the slab
+        if (fabs(d) < Threshold && (o < B.Min[a] || o > B.Max[a]))
+          return FALSE;
+
+        REAL
+          t0 = (B.Min[a] - o) / d,
+          t1 = (B.Max[a] - o) / d;
+        INT af = a * 2 + 1;
+
+        if (t0 > t1)
+          mth::Swap(t0, t1), af = a * 2;
+        if (t0 > tnear)
+          tnear = t0, f = af;
+        if (t1 < tfar)
+          tfar = t1;
+
+        // the ray passes by box or box is behind ray
+        if (tnear > tfar || tfar < 0)
+          return FALSE;
+      }
+      *T = tnear;
+      *Face = f;
+      return TRUE;
+    } /* End of 'Hit' function */
+
+    /* Is ray segment blocked by box function.
+     * ARGUMENTS:
+     *   - box index:
+     *      INT i;
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if box is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Block( INT i, const ray &R, REAL MaxT ) const
+    {
+      REAL t;
+      INT f;
+
+      return Hit(i, R, &t, &f) && t >= Threshold && t < MaxT;
+    } /* End of 'Block' function */
+
+    /* Crossing rays packet with box function.
+     * ARGUMENTS:
+     *   - box index:
+     *      INT i;
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     *   - box shape:
+     *      shape *Sh;
+     * RETURNS: None.
+     */
+    VOID HitPacket( INT i, packet &P, UINT Mask, shape *Sh ) const
+    {
+      const item &B = Items[i];
+      REAL tnear[PacketSize], tfar[PacketSize];
+      UINT Miss = 0, Hit = 0;
+
+      for (INT k = 0; k < PacketSize; k++)
+        tnear[k] = 0, tfar[k] = HUGE_VAL;
+      for (INT a = 0; a < 3; a++)
+      {
+        REAL mn = B.Min[a], mx = B.Max[a];
+
+        for (INT k = 0; k < PacketSize; k++)
+        {
+          REAL
+            o = P.Org[a][k], d = P.Dir[a][k],
+            t0 = (mn - o) / d,
+            t1 = (mx - o) / d,
+            tmin = t0 < t1 ? t0 : t1,
+            tmax = t0 < t1 ? t1 : t0;
+
+          Miss |= (fabs(d) < Threshold && (o < mn || o > mx)) << k;
+          tnear[k] = tmin > tnear[k] ? tmin : tnear[k];
+          tfar[k] = tmax < tfar[k] ? tmax : tfar[k];
+        }
+      }
+      for (INT k = 0; k < PacketSize; k++)
+        Hit |= (tnear[k] <= tfar[k] && tfar[k] >= 0 && tnear[k] < P.T[k]) << k;
+
+      Hit &= Mask & ~Miss;
+      for (INT k = 0; k < PacketSize; k++)
+        if (Hit & (1u << k))
+          P.T[k] = tnear[k], P.Sh[k] = Sh;
+    } /* End of 'HitPacket' function */
+  }; /* End of 'packed_boxes' class */
+
+  /* Packed triangles class */
+  class packed_triangles
+  {
+  public:
+    /* Triangle record class (plane and barycentric coordinates planes) */
+    class item
+    {
+    public:
+      REAL N[3], D;   // Triangle plane
+      REAL U[3], U0;  // First barycentric coordinate plane
+      REAL V[3], V0;  // Second barycentric coordinate plane
+    }; /* End of 'item' class */
+
+    std::vector<item> Items;  // Triangles records
+
+    /* Add triangle function.
+     * ARGUMENTS:
+     *   - triangle plane:
+     *      const vec3 &N; REAL D;
+     *   - barycentric coordinate planes:
+     *      const vec3 &U; REAL U0;
+     *      const vec3 &V; REAL V0;
+     * RETURNS:
+     *   (INT) triangle index.
+     */
+    INT Add( const vec3 &N, REAL D, const vec3 &U, REAL U0, const vec3 &V, REAL V0 )
+    {
+      Items.push_back({{N[0], N[1], N[2]}, D, {U[0], U[1], U[2]}, U0, {V[0], V[1], V[2]}, V0});
+      return static_cast<INT>(Items.size()) - 1;
+    } /* End of 'Add' function */
+
+    /* Find triangle crossing function.
+     * ARGUMENTS:
+     *   - triangle index:
+     *      INT i;
+     *   - ray:
+     *      const ray &R;
+     *   - hit distance pointer:
+     *      REAL *T;
+     *   - crossed face pointer (unused):
+     *      INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if triangle is crossed (as 'triangle::Intersect').
+     */
+    BOOL Hit( INT i, const ray &R, REAL *T, INT *Face ) const
+    {
+      GORT_STAT_INC(TRIANGLE_TESTS);
+      const item &Tr = Items[i];
+      REAL nd = Tr.N[0] * R.Dir[0] + Tr.N[1] * R.Dir[1] + Tr.N[2] * R.Dir[2];
+
+      if (fabs(nd) < Threshold)
+        return FALSE;
+
+      REAL t = -((R.Org[0] * Tr.N[0] + R.Org[1] * Tr.N[1] + R.Org[2] * Tr.N[2]) + Tr.D) / nd;
+
+      if (t < Threshold)
+        return FALSE;
+
+      REAL
+        px = R.Org[0] + R.Dir[0] * t,
+        py = R.Org[1] + R.Dir[1] * t,
+        pz = R.Org[2] + R.Dir[2] * t,
+        u = (px * Tr.U[0] + py * Tr.U[1] + pz * Tr.U[2]) - Tr.U0,
+        v = (px * Tr.V[0] + py * Tr.V[1] + pz * Tr.V[2]) - Tr.V0;
+
+      if (u >= 0 && u <= 1 && v >= 0 && v <= 1 && u + v <= 1)
+      {
+        *T = t;
+        return TRUE;
+      }
+      return FALSE;
+    } /* End of 'Hit' function */
+
+    /* Is ray segment blocked by triangle function.
+     * ARGUMENTS:
+     *   - triangle index:
+     *      INT i;
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if triangle is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Block( INT i, const ray &R, REAL MaxT ) const
+    {
+      REAL t;
+      INT f;
+
+      return Hit(i, R, &t, &f) && t < MaxT;
+    } /* End of 'Block' function */
+
+    /* Crossing rays packet with triangle function.
+     * ARGUMENTS:
+     *   - triangle index:
+     *      INT i;
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     *   - triangle shape:
+     *      shape *Sh;
+     * RETURNS: None.
+     */
+    VOID HitPacket( INT i, packet &P, UINT Mask, shape *Sh ) const
+    {
+      const item &Tr = Items[i];
+      REAL t[PacketSize];
+      UINT Hit = 0;
+
+      for (INT k = 0; k < PacketSize; k++)
+      {
+        REAL
+          nd = Tr.N[0] * P.Dir[0][k] + Tr.N[1] * P.Dir[1][k] + Tr.N[2] * P.Dir[2][k],
+          no = Tr.N[0] * P.Org[0][k] + Tr.N[1] * P.Org[1][k] + Tr.N[2] * P.Org[2][k];
+
+        t[k] = -(no + Tr.D) / nd;
+
+        REAL
+          px = P.Org[0][k] + P.Dir[0][k] * t[k],
+          py = P.Org[1][k] + P.Dir[1][k] * t[k],
+          pz = P.Org[2][k] + P.Dir[2][k] * t[k],
+          u = px * Tr.U[0] + py * Tr.U[1] + pz * Tr.U[2] - Tr.U0,
+          v = px * Tr.V[0] + py * Tr.V[1] + pz * Tr.V[2] - Tr.V0;
+
+        Hit |= (fabs(nd) >= Threshold && t[k] >= Threshold && t[k] < P.T[k] &&
+                u >= 0 && u <= 1 && v >= 0 && v <= 1 && u + v <= 1) << k;
+      }
+
+      Hit &= Mask;
+      for (INT k = 0; k < PacketSize; k++)
+        if (Hit & (1u << k))
+          P.T[k] = t[k], P.Sh[k] = Sh;
+    } /* End of 'HitPacket' function */
+  }; /* End of 'packed_triangles' class */
+
+  /* Packed planes class */
+  class packed_planes
+  {
+  public:
+    /* Plane record class */
+    class item
+    {
+    public:
+      REAL N[3], D;  // Plane equation
+    }; /* End of 'item' class */
+
+    std::vector<item> Items;  // Planes records
+
+    /* Add plane function.
+     * ARGUMENTS:
+     *   - plane equation:
+     *      const vec3 &N; REAL D;
+     * RETURNS:
+     *   (INT) plane index.
+     */
+    INT Add( const vec3 &N, REAL D )
+    {
+      Items.push_back({{N[0], N[1], N[2]}, D});
+      return static_cast<INT>(Items.size()) - 1;
+    } /* End of 'Add' function */
+
+    /* Find plane crossing function.
+     * ARGUMENTS:
+     *   - plane index:
+     *      INT i;
+     *   - ray:
+     *      const ray &R;
+     *   - hit distance pointer:
+     *      REAL *T;
+     *   - crossed face pointer (unused):
+     *      INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if plane is crossed (as 'plane::Intersect').
+     */
+    BOOL Hit( INT i, const ray &R, REAL *T, INT *Face ) const
+    {
+      GORT_STAT_INC(PLANE_TESTS);
+      const item &Pl = Items[i];
+      REAL nd = Pl.N[0] * R.Dir[0] + Pl.N[1] * R.Dir[1] + Pl.N[2] * R.Dir[2];
+
+      if (fabs(nd) < Threshold)
+        return FALSE;
+
+      REAL t = -((R.Org[0] * Pl.N[0] + R.Org[1] * Pl.N[1] + R.Org[2] * Pl.N[2]) + Pl.D) / nd;
+
+      if (t < Threshold)
+        return FALSE;
+      *T = t;
+      return TRUE;
+    } /* End of 'Hit' function */
+
+    /* Is ray segment blocked by plane function.
+     * ARGUMENTS:
+     *   - plane index:
+     *      INT i;
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if plane is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Block( INT i, const ray &R, REAL MaxT ) const
+    {
+      REAL t;
+      INT f;
+
+      return Hit(i, R, &t, &f) && t < MaxT;
+    } /* End of 'Block' function */
+
+    /* Crossing rays packet with plane function.
+     * ARGUMENTS:
+     *   - plane index:
+     *      INT i;
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     *   - plane shape:
+     *      shape *Sh;
+     * RETURNS: None.
+     */
+    VOID HitPacket( INT i, packet &P, UINT Mask, shape *Sh ) const
+    {
+      const item &Pl = Items[i];
+      REAL t[PacketSize];
+      UINT Hit = 0;
+
+      for (INT k = 0; k < PacketSize; k++)
+      {
+        REAL
+          nd = Pl.N[0] * P.Dir[0][k] + Pl.N[1] * P.Dir[1][k] + Pl.N[2] * P.Dir[2][k],
+          no = Pl.N[0] * P.Org[0][k] + Pl.N[1] * P.Org[1][k] + Pl.N[2] * P.Org[2][k];
+
+        t[k] = -(no + Pl.D) / nd;
+        Hit |= (fabs(nd) >= Threshold && t[k] >= Threshold && t[k] < P.T[k]) << k;
+      }
+
+      Hit &= Mask;
+      for (INT k = 0; k < PacketSize; k++)
+        if (Hit & (1u << k))
+          P.T[k] = t[k], P.Sh[k] = Sh;
+    } /* End of 'HitPacket' function */
+  }; /* End of 'packed_planes' class */
+
+  /* Packed simple shapes storage class.
+   * Spheres, boxes, triangles and planes are copied to contiguous per
+   * type arrays of compact records, other shapes are left to the scene
+   * virtual calls. Bounded shapes share one hierarchy, its leaves are
+   * renumbered and every type array is reordered by leaves, so a leaf
+   * reads neighbour array elements. Shape type is selected by switch
+   * (shapes of a leaf are grouped by type), hit tests are compiled
+   * inline for every type. */
+  class packed_shapes
+  {
+  private:
+    /* Bounded shape types */
+    enum kind : BYTE
+    {
+      SPHERE, BOX, TRIANGLE
+    };
+
+    packed_spheres Spheres;           // Packed spheres
+    packed_boxes Boxes;               // Packed boxes
+    packed_triangles Triangles;       // Packed triangles
+    packed_planes Planes;             // Packed planes (not in hierarchy)
+    std::vector<kind> Kinds;          // Bounded shapes types (by hierarchy index)
+    std::vector<INT> Index;           // Bounded shapes indices in type arrays (by hierarchy index)
+    std::vector<shape *> Owners;      // Bounded shapes to take material and normal from (by hierarchy index)
+    std::vector<shape *> PlaneOwners; // Planes to take material and normal from
+    std::vector<aabb> Bounds;         // Bounded shapes boxes (until build)
+    bvh Tree;                         // Bounded shapes hierarchy
+
+    /* Add bounded shape function.
+     * ARGUMENTS:
+     *   - shape type:
+     *      kind Kind;
+     *   - index in type array:
+     *      INT Item;
+     *   - shape:
+     *      shape *Sh;
+     *   - shape bounding box:
+     *      const aabb &BB;
+     * RETURNS: None.
+     */
+    VOID AddBounded( kind Kind, INT Item, shape *Sh, const aabb &BB )
+    {
+      Kinds.push_back(Kind);
+      Index.push_back(Item);
+      Owners.push_back(Sh);
+      Bounds.push_back(BB);
+    } /* End of 'AddBounded' function */
+
+    /* Find bounded shape crossing function.
+     * ARGUMENTS:
+     *   - hierarchy index:
+     *      INT i;
+     *   - ray:
+     *      const ray &R;
+     *   - hit distance and face pointers:
+     *      REAL *T; INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed.
+     */
+    BOOL Hit( INT i, const ray &R, REAL *T, INT *Face ) const
+    {
+      switch (Kinds[i])
+      {
+      case SPHERE:
+        return Spheres.Hit(Index[i], R, T, Face);
+      case BOX:
+        return Boxes.Hit(Index[i], R, T, Face);
+      default:
+        return Triangles.Hit(Index[i], R, T, Face);
+      }
+    } /* End of 'Hit' function */
+
+  public:
+    /* Clear storage function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID )
+    {
+      *this = packed_shapes();
+    } /* End of 'Clear' function */
+
+    /* Add shape to storage function.
+     * ARGUMENTS:
+     *   - shape to be copied:
+     *      shape *Sh;
+     * RETURNS:
+     *   (BOOL) TRUE if shape type is packed.
+     */
+    BOOL Add( shape *Sh );
+
+    /* Build storage function.
+     * ARGUMENTS:
+     *   - hierarchy build mode:
+     *      bvh::mode Mode;
+     *   - hierarchy subtree tasks pool (may be nullptr):
+     *      pool *Pool;
+     * RETURNS: None.
+     */
+    VOID Build( bvh::mode Mode, pool *Pool );
+
+    /* Obtain shapes hierarchy function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const bvh &) bounded shapes hierarchy.
+     */
+    const bvh & GetTree( VOID ) const
+    {
+      return Tree;
+    } /* End of 'GetTree' function */
+
+    /* Obtain packed shapes count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) shapes count.
+     */
+    INT GetCount( VOID ) const
+    {
+      return static_cast<INT>(Owners.size() + PlaneOwners.size());
+    } /* End of 'GetCount' function */
+
+    /* Find closest crossing function.
+     * ARGUMENTS:
+     *   - ray:
+     *      const ray &R;
+     *   - closest hit distance (decreased by closer hit):
+     *      REAL &MaxT;
+     *   - crossed shape and face pointers:
+     *      shape **Sh; INT *Face;
+     * RETURNS:
+     *   (BOOL) TRUE if closer shape is crossed.
+     */
+    BOOL Intersect( const ray &R, REAL &MaxT, shape **Sh, INT *Face ) const
+    {
+      BOOL IsHit = FALSE;
+      REAL t;
+      INT f = 0;
+
+      for (INT i = 0; i < static_cast<INT>(PlaneOwners.size()); i++)
+        if (Planes.Hit(i, R, &t, &f) && t < MaxT)
+          MaxT = t, *Sh = PlaneOwners[i], *Face = f, IsHit = TRUE;
+      return Tree.Intersect(R, MaxT,
+        [&]( INT i, REAL &Max )
+        {
+          if (Hit(i, R, &t, &f) && t < Max)
+          {
+            MaxT = Max = t;
+            *Sh = Owners[i];
+            *Face = f;
+            return TRUE;
+          }
+          return FALSE;
+        }) || IsHit;
+    } /* End of 'Intersect' function */
+
+    /* Is ray segment blocked function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if any shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) const
+    {
+      for (INT i = 0; i < static_cast<INT>(PlaneOwners.size()); i++)
+        if (Planes.Block(i, R, MaxT))
+          return TRUE;
+      return Tree.Occluded(R, MaxT,
+        [&]( INT i )
+        {
+          switch (Kinds[i])
+          {
+          case SPHERE:
+            return Spheres.Block(Index[i], R, MaxT);
+          case BOX:
+            return Boxes.Block(Index[i], R, MaxT);
+          default:
+            return Triangles.Block(Index[i], R, MaxT);
+          }
+        });
+    } /* End of 'Occluded' function */
+
+    /* Find closest crossings for rays packet function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     * RETURNS: None.
+     */
+    VOID Intersect( packet &P ) const
+    {
+      for (INT i = 0; i < static_cast<INT>(PlaneOwners.size()); i++)
+        Planes.HitPacket(i, P, P.Active, PlaneOwners[i]);
+      Tree.Intersect(P,
+        [&]( INT i, UINT Mask )
+        {
+          switch (Kinds[i])
+          {
+          case SPHERE:
+            Spheres.HitPacket(Index[i], P, Mask, Owners[i]);
+            break;
+          case BOX:
+            Boxes.HitPacket(Index[i], P, Mask, Owners[i]);
+            break;
+          default:
+            Triangles.HitPacket(Index[i], P, Mask, Owners[i]);
+            break;
+          }
+        });
+    } /* End of 'Intersect' function */
+  }; /* End of 'packed_shapes' class */
+} /* end of 'gort' namespace */
+
+#endif /* __packed_h_ */
+
+/* END OF 'packed.h' FILE */
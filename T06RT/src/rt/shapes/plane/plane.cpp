@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               plane shape class functions implementation module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 02.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -20,29 +20,52 @@
  * ARGUMENTS:
  *   - ray from camera:
  *      const ray &R;
- *   - intersection data pointer:
- *      intr *Intr;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
  * RETURNS:
- *   (BOOL) Is intersection with plane.
+ *   (BOOL) TRUE if plane is crossed closer than 'H->T'.
  */
-BOOL gort::plane::Intersect( const ray &R, intr *Intr )
+BOOL gort::plane::Intersect( const ray &R, hit *H )
 {
+  GORT_STAT_INC(PLANE_TESTS);
   // Check for intersect existing
-  DBL nd = N & R.Dir;
+  REAL nd = N & R.Dir;
   if (fabs(nd) < Threshold)
     return FALSE;
 
-  DBL t = -((R.Org & N) + D) / nd;
+  REAL t = -((R.Org & N) + D) / nd;
 
-  if (t < Threshold)
+  if (t < Threshold || t >= H->T)
     return FALSE;
 
-  Intr->T = t;
-  Intr->Sh = this;
+  H->T = t;
+  H->Sh = this;
   return TRUE;
 } /* End of 'Intersection' function */
 
+/* Is ray segment blocked by plane function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if plane is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::plane::Occluded( const ray &R, REAL MaxT )
+{
+  GORT_STAT_INC(PLANE_TESTS);
+  REAL nd = N & R.Dir;
+  if (fabs(nd) < Threshold)
+    return FALSE;
+
+  REAL t = -((R.Org & N) + D) / nd;
+
+  return t >= Threshold && t < MaxT;
+} /* End of 'Occluded' function */
+
 /* Evaluate shape normal function.
+ * Texture repeats every distance unit along plane basis.
  * ARGUMENTS:
  *   - intersection data pointer:
  *      intr *Intr;
@@ -50,9 +73,42 @@ BOOL gort::plane::Intersect( const ray &R, intr *Intr )
  */
 VOID gort::plane::GetNormal( intr *Intr )
 {
+  vec3
+    T = ((fabs(N[0]) > 0.5 ? vec3(0, 1, 0) : vec3(1, 0, 0)) % N).Normalizing(),
+    B = N % T;
+
   Intr->N = N;
+  Intr->Tex = vec2(Intr->P & T, Intr->P & B);
+  Intr->TexScale = 1;
 } /* End of 'GetNormal' funciton */
 
+/* Crossing rays packet with plane function.
+ * ARGUMENTS:
+ *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+ *      packet &P;
+ *   - tested lanes mask:
+ *      UINT Mask;
+ * RETURNS: None.
+ */
+VOID gort::plane::IntersectPacket( packet &P, UINT Mask )
+{
+  REAL t[PacketSize];
+  UINT Hit = 0;
+
+  for (INT i = 0; i < PacketSize; i++)
+  {
+    REAL
+      nd = N[0] * P.Dir[0][i] + N[1] * P.Dir[1][i] + N[2] * P.Dir[2][i],
+      no = N[0] * P.Org[0][i] + N[1] * P.Org[1][i] + N[2] * P.Org[2][i];
+
+    t[i] = -(no + D) / nd;
+    Hit |= (fabs(nd) >= Threshold && t[i] >= Threshold && t[i] < P.T[i]) << i;
+  }
 
+  Hit &= Mask;
+  for (INT i = 0; i < PacketSize; i++)
+    if (Hit & (1u << i))
+      P.T[i] = t[i], P.Sh[i] = this;
+} /* End of 'IntersectPacket' function */
 
 /* END OF 'plane.cpp' FILE */
\ No newline at end of file
@@ -26,21 +26,23 @@ namespace gort
   /* Plane class */
   class plane : public shape
   {
+    friend class packed_shapes;
+
   private:
     vec3 N; // Plane normal
     vec3 P; // Plane point
-    DBL D;  // Plane distance (N & P)
+    REAL D;  // Plane distance (N & P)
 
     /* Get crossing with plane function.
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
      * RETURNS:
-     *   (BOOL) Is intersection with plane.
+     *   (BOOL) TRUE if plane is crossed closer than 'H->T'.
      */
-    BOOL Intersect( const ray &R, intr *Intr ) override;
+    BOOL Intersect( const ray &R, hit *H ) override;
 
     /* Evaluate shape normal function.
      * ARGUMENTS:
@@ -50,6 +52,27 @@ namespace gort
      */
     VOID GetNormal( intr *Intr ) override;
 
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Crossing rays packet with shape function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    VOID IntersectPacket( packet &P, UINT Mask ) override;
+
   public:
 
     /* Default constructor */
@@ -76,11 +99,11 @@ namespace gort
      *   - plane normal:
      *     const vec3 &NewN;
      *   - plane distance:
-     *     const DBL &NewD;
+     *     const REAL &NewD;
      *   - plane material:
      *     const surface &NewMtl;
      */
-    plane( const vec3 &NewN, const DBL &NewD, const surface &NewMtl ) : N(NewN.Normalizing()), D(NewD)
+    plane( const vec3 &NewN, const REAL &NewD, const surface &NewMtl ) : N(NewN.Normalizing()), D(NewD)
     {
       Mtl = NewMtl;
     } /* End of 'plane' function */
@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Sphere shape class functions implementation module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 02.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -20,43 +20,75 @@
  * ARGUMENTS:
  *   - ray from camera:
  *      const ray &R;
- *   - intersection data pointer:
- *      intr *Intr;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
  * RETURNS:
- *   (BOOL) Is intersection with sphere.
+ *   (BOOL) TRUE if sphere is crossed closer than 'H->T'.
  */
-BOOL gort::sphere::Intersect( const ray &R, intr *Intr )
+BOOL gort::sphere::Intersect( const ray &R, hit *H )
 {
+  GORT_STAT_INC(SPHERE_TESTS);
   vec3 a = C - R.Org;
-  DBL OC2 = a & a;
-  DBL OK = a & R.Dir;
-  DBL h2 = R2 - (OC2 - OK * OK);
+  REAL OC2 = a & a;
+  REAL OK = a & R.Dir;
+  REAL h2 = R2 - (OC2 - OK * OK), t;
 
   // the ray starts inside the sphere
   if (OC2 < R2)
+    t = OK + sqrt(h2);
+  else
   {
-    Intr->T = OK + sqrt(h2);
-    Intr->Sh = this;
-    Intr->N = (R(Intr->T) - C).Normalizing();
-    return true;
-  }
+    // the ray leaves the center of the sphere behind
+    if (OK < 0)
+      return false;
 
-  // the ray leaves the center of the sphere behind
-  if (OK < 0)
-    return false;
+    // the ray passes by the sphere
+    if (h2 < 0)
+      return false;
 
-  // the ray passes by the sphere
-  if (h2 < 0)
-    return false;
+    // the ray starts from outside the sphere
+    t = OK - sqrt(h2);
+  }
 
-  // the ray starts from outside the sphere
-  Intr->T = OK - sqrt(h2);
-  Intr->Sh = this;
-  Intr->P = R(Intr->T);
+  if (t >= H->T)
+    return false;
+  H->T = t;
+  H->Sh = this;
   return true;
 } /* End of 'Intersection' function */
 
+/* Is ray segment blocked by sphere function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if sphere is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::sphere::Occluded( const ray &R, REAL MaxT )
+{
+  GORT_STAT_INC(SPHERE_TESTS);
+  vec3 a = C - R.Org;
+  REAL OC2 = a & a;
+  REAL OK = a & R.Dir;
+  REAL h2 = R2 - (OC2 - OK * OK), t;
+
+  // the ray starts inside the sphere
+  if (OC2 < R2)
+    t = OK + sqrt(h2);
+  else
+  {
+    // the ray leaves the sphere behind or passes by
+    if (OK < 0 || h2 < 0)
+      return FALSE;
+    t = OK - sqrt(h2);
+  }
+  return t >= Threshold && t < MaxT;
+} /* End of 'Occluded' function */
+
 /* Evaluate shape normal function.
+ * Texture is mapped by longitude and latitude (V = 0 at top pole).
  * ARGUMENTS:
  *   - intersection data pointer:
  *      intr *Intr;
@@ -65,7 +97,57 @@ BOOL gort::sphere::Intersect( const ray &R, intr *Intr )
 VOID gort::sphere::GetNormal( intr *Intr )
 {
   Intr->N = (Intr->P - C).Normalizing();
+  Intr->Tex = vec2(atan2(Intr->N[2], Intr->N[0]) / (2 * mth::PI) + 0.5, acos(mth::Clamp<REAL>(Intr->N[1], -1, 1)) / mth::PI);
+  Intr->TexScale = 1 / (mth::PI * sqrt(R2));
 } /* End of 'GetNormal' funciton */
 
+/* Obtain shape bounding box function.
+ * ARGUMENTS:
+ *   - bounding box pointer:
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if shape is bounded.
+ */
+BOOL gort::sphere::GetBB( aabb *BB )
+{
+  REAL R = sqrt(R2);
+
+  *BB = aabb(C - vec3(R), C + vec3(R));
+  return TRUE;
+} /* End of 'GetBB' funciton */
+
+/* Crossing rays packet with sphere function.
+ * ARGUMENTS:
+ *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+ *      packet &P;
+ *   - tested lanes mask:
+ *      UINT Mask;
+ * RETURNS: None.
+ */
+VOID gort::sphere::IntersectPacket( packet &P, UINT Mask )
+{
+  REAL t[PacketSize];
+  UINT Hit = 0;
+
+  for (INT i = 0; i < PacketSize; i++)
+  {
+    REAL
+      ax = C[0] - P.Org[0][i], ay = C[1] - P.Org[1][i], az = C[2] - P.Org[2][i],
+      OC2 = ax * ax + ay * ay + az * az,
+      OK = ax * P.Dir[0][i] + ay * P.Dir[1][i] + az * P.Dir[2][i],
+      h2 = R2 - (OC2 - OK * OK),
+      h = sqrt(h2 > 0 ? h2 : 0);
+    BOOL Inside = OC2 < R2;
+
+    // same cases as scalar test: inside, or in front and not passing by
+    t[i] = Inside ? OK + h : OK - h;
+    Hit |= ((Inside || (OK >= 0 && h2 >= 0)) && t[i] < P.T[i]) << i;
+  }
+
+  Hit &= Mask;
+  for (INT i = 0; i < PacketSize; i++)
+    if (Hit & (1u << i))
+      P.T[i] = t[i], P.Sh[i] = this;
+} /* End of 'IntersectPacket' function */
 
 /* END OF 'sphere.cpp' FILE */
\ No newline at end of file
@@ -28,20 +28,22 @@ namespace gort
   /* Sphere class */
   class sphere : public shape
   {
+    friend class packed_shapes;
+
   private:
     vec3 C; // Sphere centre
-    DBL R2; // Sphere square number
+    REAL R2; // Sphere square number
 
     /* Get crossing with sphere function.
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
      * RETURNS:
-     *   (BOOL) Is intersection with sphere.
+     *   (BOOL) TRUE if sphere is crossed closer than 'H->T'.
      */
-    BOOL Intersect( const ray &R, intr *Intr ) override;
+    BOOL Intersect( const ray &R, hit *H ) override;
 
     /* Evaluate shape normal function.
      * ARGUMENTS:
@@ -51,6 +53,36 @@ namespace gort
      */
     VOID GetNormal( intr *Intr ) override;
 
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is bounded.
+     */
+    BOOL GetBB( aabb *BB ) override;
+
+    /* Crossing rays packet with shape function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    VOID IntersectPacket( packet &P, UINT Mask ) override;
+
   public:
 
     /* Default constructor */
@@ -63,11 +95,11 @@ namespace gort
      *   - sphere centre:
      *     const vec3 &NewC;
      *   - sphere radius:
-     *     const DBL &NewR;
+     *     const REAL &NewR;
      *   - sphere material:
      *     const surface &NewMtl;
      */
-    sphere( const vec3 &NewC, const DBL &NewR, const surface &NewMtl ) : C(NewC), R2(NewR * NewR)
+    sphere( const vec3 &NewC, const REAL &NewR, const surface &NewMtl ) : C(NewC), R2(NewR * NewR)
     {
       Mtl = NewMtl;
     } /* End of 'sphere' function */
@@ -77,11 +109,11 @@ namespace gort
      *   - sphere centre:
      *     const vec3 &NewC;
      *   - sphere radius:
-     *     const DBL &NewR;
+     *     const REAL &NewR;
      *   - sphere material:
      *     const surface &NewMtl;
      */
-    sphere( const vec3 &NewC, const DBL &NewR, const surface &NewMtl, const envi &NewEnvi ) : C(NewC), R2(NewR * NewR)
+    sphere( const vec3 &NewC, const REAL &NewR, const surface &NewMtl, const envi &NewEnvi ) : C(NewC), R2(NewR * NewR)
     {
       Mtl = NewMtl;
       Media = NewEnvi;
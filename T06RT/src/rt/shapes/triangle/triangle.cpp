@@ -7,7 +7,7 @@
  * PURPOSE     : Ray tracing project.
  *               Triangle shape class functions implementation module.
  * PROGRAMMER  : Dan Gorlyakov.
- * LAST UPDATE : 02.08.2021.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'gort'.
  *
  * No part of this file may be changed without agreement of
@@ -20,40 +20,71 @@
  * ARGUMENTS:
  *   - ray from camera:
  *      const ray &R;
- *   - intersection data pointer:
- *      intr *Intr;
+ *   - closest hit pointer (updated by closer hit only):
+ *      hit *H;
  * RETURNS:
- *   (BOOL) Is intersection with triangle.
+ *   (BOOL) TRUE if triangle is crossed closer than 'H->T'.
  */
-BOOL gort::triangle::Intersect( const ray &R, intr *Intr )
+BOOL gort::triangle::Intersect( const ray &R, hit *H )
 {
+  GORT_STAT_INC(TRIANGLE_TESTS);
   // Check for intersect existing
-  DBL nd = N & R.Dir;
+  REAL nd = N & R.Dir;
   if (fabs(nd) < Threshold)
     return FALSE;
 
-  DBL t = -((R.Org & N) + D) / nd;
+  REAL t = -((R.Org & N) + D) / nd;
 
-  if (t < Threshold)
+  if (t < Threshold || t >= H->T)
     return FALSE;
 
   vec3 P = R(t);
 
-  DBL
+  REAL
     u = (P & U1) - u0,
     v = (P & V1) - v0;
 
   if (u >= 0 && u <= 1 && v >= 0 && v <=1 && u + v <= 1)
   {
-    Intr->T = t;
-    Intr->P = R(t);
-    Intr->Sh = this;
+    H->T = t;
+    H->Sh = this;
     return TRUE;
   }
   return FALSE;
 } /* End of 'Intersection' function */
 
+/* Is ray segment blocked by triangle function.
+ * ARGUMENTS:
+ *   - ray from point:
+ *      const ray &R;
+ *   - segment length:
+ *      REAL MaxT;
+ * RETURNS:
+ *   (BOOL) TRUE if triangle is crossed at distance in [Threshold, MaxT).
+ */
+BOOL gort::triangle::Occluded( const ray &R, REAL MaxT )
+{
+  GORT_STAT_INC(TRIANGLE_TESTS);
+  REAL nd = N & R.Dir;
+  if (fabs(nd) < Threshold)
+    return FALSE;
+
+  REAL t = -((R.Org & N) + D) / nd;
+
+  if (t < Threshold || t >= MaxT)
+    return FALSE;
+
+  vec3 P = R(t);
+
+  REAL
+    u = (P & U1) - u0,
+    v = (P & V1) - v0;
+
+  return u >= 0 && u <= 1 && v >= 0 && v <= 1 && u + v <= 1;
+} /* End of 'Occluded' function */
+
 /* Evaluate shape normal function.
+ * Barycentric coordinates of point are its texture coordinates.
  * ARGUMENTS:
  *   - intersection data pointer:
  *      intr *Intr;
@@ -62,8 +93,62 @@ BOOL gort::triangle::Intersect( const ray &R, intr *Intr )
 VOID gort::triangle::GetNormal( intr *Intr )
 {
   Intr->N = N;
+  Intr->Tex = vec2((Intr->P & U1) - u0, (Intr->P & V1) - v0);
+  Intr->TexScale = 1 / sqrt(!N);
 } /* End of 'GetNormal' funciton */
 
+/* Obtain shape bounding box function.
+ * ARGUMENTS:
+ *   - bounding box pointer:
+ *      aabb *BB;
+ * RETURNS:
+ *   (BOOL) TRUE if shape is bounded.
+ */
+BOOL gort::triangle::GetBB( aabb *BB )
+{
+  *BB = aabb();
+  BB->Grow(P0);
+  BB->Grow(P1);
+  BB->Grow(P2);
+  return TRUE;
+} /* End of 'GetBB' funciton */
+
+/* Crossing rays packet with triangle function.
+ * ARGUMENTS:
+ *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+ *      packet &P;
+ *   - tested lanes mask:
+ *      UINT Mask;
+ * RETURNS: None.
+ */
+VOID gort::triangle::IntersectPacket( packet &P, UINT Mask )
+{
+  REAL t[PacketSize];
+  UINT Hit = 0;
+
+  for (INT i = 0; i < PacketSize; i++)
+  {
+    REAL
+      nd = N[0] * P.Dir[0][i] + N[1] * P.Dir[1][i] + N[2] * P.Dir[2][i],
+      no = N[0] * P.Org[0][i] + N[1] * P.Org[1][i] + N[2] * P.Org[2][i];
+
+    t[i] = -(no + D) / nd;
+
+    REAL
+      px = P.Org[0][i] + P.Dir[0][i] * t[i],
+      py = P.Org[1][i] + P.Dir[1][i] * t[i],
+      pz = P.Org[2][i] + P.Dir[2][i] * t[i],
+      u = px * U1[0] + py * U1[1] + pz * U1[2] - u0,
+      v = px * V1[0] + py * V1[1] + pz * V1[2] - v0;
+
+    Hit |= (fabs(nd) >= Threshold && t[i] >= Threshold && t[i] < P.T[i] &&
+            u >= 0 && u <= 1 && v >= 0 && v <= 1 && u + v <= 1) << i;
+  }
 
+  Hit &= Mask;
+  for (INT i = 0; i < PacketSize; i++)
+    if (Hit & (1u << i))
+      P.T[i] = t[i], P.Sh[i] = this;
+} /* End of 'IntersectPacket' function */
 
 /* END OF 'triangle.cpp' FILE */
\ No newline at end of file
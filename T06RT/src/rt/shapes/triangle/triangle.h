@@ -26,23 +26,25 @@ namespace gort
   /* Triangle class */
   class triangle : public shape
   {
+    friend class packed_shapes;
+
   private:
     vec3 P0, P1, P2; // Triangle points
     vec3 N;          // Triangle normal
-    DBL D;           // Distance to plane
+    REAL D;           // Distance to plane
     vec3 U1, V1;
-    DBL u0, v0;
+    REAL u0, v0;
 
     /* Get crossing with triangle function.
      * ARGUMENTS:
      *   - ray from camera:
      *      const ray &R;
-     *   - intersection data pointer:
-     *      intr *Intr;
+     *   - closest hit pointer (updated by closer hit only):
+     *      hit *H;
      * RETURNS:
-     *   (BOOL) Is intersection with triangle.
+     *   (BOOL) TRUE if triangle is crossed closer than 'H->T'.
      */
-    BOOL Intersect( const ray &R, intr *Intr ) override;
+    BOOL Intersect( const ray &R, hit *H ) override;
 
     /* Evaluate shape normal function.
      * ARGUMENTS:
@@ -52,6 +54,36 @@ namespace gort
      */
     VOID GetNormal( intr *Intr ) override;
 
+    /* Is ray segment blocked by shape function.
+     * ARGUMENTS:
+     *   - ray from point:
+     *      const ray &R;
+     *   - segment length:
+     *      REAL MaxT;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is crossed at distance in [Threshold, MaxT).
+     */
+    BOOL Occluded( const ray &R, REAL MaxT ) override;
+
+    /* Obtain shape bounding box function.
+     * ARGUMENTS:
+     *   - bounding box pointer:
+     *      aabb *BB;
+     * RETURNS:
+     *   (BOOL) TRUE if shape is bounded.
+     */
+    BOOL GetBB( aabb *BB ) override;
+
+    /* Crossing rays packet with shape function.
+     * ARGUMENTS:
+     *   - rays packet (closer hits update 'T' and 'Sh' of lanes):
+     *      packet &P;
+     *   - tested lanes mask:
+     *      UINT Mask;
+     * RETURNS: None.
+     */
+    VOID IntersectPacket( packet &P, UINT Mask ) override;
+
   public:
     /* Default constructor */
     triangle( VOID )
@@ -72,7 +104,7 @@ namespace gort
         s1 = P1 - P0,
         s2 = P2 - P0;
 
-      D = N & P0;
+      D = -(N & P0);
 
       U1 = (s1 * (s2 & s2) - s2 * (s1 & s2)) /
            ((s1 & s1) * (s2 & s2) - (s1 & s2) * (s1 & s2));
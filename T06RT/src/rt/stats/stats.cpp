@@ -0,0 +1,178 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : stats.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Rendering statistics counters implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "stats.h"
+
+/* Counter names (JSON keys and CSV rows) */
+static const CHAR *StatsCounterNames[gort::stats::COUNTER_COUNT] =
+{
+  "camera_rays", "secondary_rays", "missed_rays", "shadow_rays", "shadow_blocked", "shade_calls", "light_samples",
+  "node_visits", "packet_visits", "sphere_tests", "box_tests", "triangle_tests", "plane_tests", "mesh_tests",
+  "instance_tests", "texel_quads", "texel_hits"
+};
+
+/* Timer names */
+static const CHAR *StatsTimerNames[gort::stats::TIMER_COUNT] =
+{
+  "build_time", "tile_time", "shadow_time"
+};
+
+/* Thread blocks registry class */
+class stats_registry
+{
+public:
+  std::mutex Lock;                     // Registry lock
+  std::vector<gort::stats *> Blocks;   // Blocks of live threads
+  gort::stats Retired;                 // Sum of finished threads blocks
+}; /* End of 'stats_registry' class */
+
+/* Obtain registry function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (stats_registry &) registry.
+ */
+static stats_registry & StatsRegistry( VOID )
+{
+  static stats_registry Registry;
+
+  return Registry;
+} /* End of 'StatsRegistry' function */
+
+/* Registered thread block class */
+class stats_block : public gort::stats
+{
+public:
+  /* Register block constructor */
+  stats_block( VOID )
+  {
+    stats_registry &R = StatsRegistry();
+    std::lock_guard<std::mutex> Guard(R.Lock);
+
+    R.Blocks.push_back(this);
+  } /* End of 'stats_block' function */
+
+  /* Unregister block destructor (counts are kept in retired sum) */
+  ~stats_block( VOID )
+  {
+    stats_registry &R = StatsRegistry();
+    std::lock_guard<std::mutex> Guard(R.Lock);
+
+    R.Retired += *this;
+    R.Blocks.erase(std::find(R.Blocks.begin(), R.Blocks.end(), this));
+  } /* End of '~stats_block' function */
+}; /* End of 'stats_block' class */
+
+/* Obtain current thread statistics function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (stats &) thread statistics block.
+ */
+gort::stats & gort::stats::Local( VOID )
+{
+  static thread_local stats_block Block;
+
+  return Block;
+} /* End of 'Local' function */
+
+/* Sum statistics of all threads function.
+ * ARGUMENTS:
+ *   - clear thread blocks flag:
+ *      BOOL IsReset;
+ * RETURNS:
+ *   (stats) summed statistics.
+ */
+gort::stats gort::stats::Collect( BOOL IsReset )
+{
+  stats_registry &R = StatsRegistry();
+  std::lock_guard<std::mutex> Guard(R.Lock);
+  stats Sum = R.Retired;
+
+  for (auto B : R.Blocks)
+  {
+    Sum += *B;
+    if (IsReset)
+      *B = stats();
+  }
+  if (IsReset)
+    R.Retired = stats();
+  return Sum;
+} /* End of 'Collect' function */
+
+/* Save statistics by file extension function.
+ * ARGUMENTS:
+ *   - file name ('*.csv' for name,value lines, JSON otherwise):
+ *      const std::string &FileName;
+ *   - run label (scene and settings):
+ *      const std::string &Label;
+ * RETURNS:
+ *   (BOOL) TRUE if file saved.
+ */
+BOOL gort::stats::Save( const std::string &FileName, const std::string &Label ) const
+{
+  FILE *F = fopen(FileName.c_str(), "w");
+
+  if (F == nullptr)
+    return FALSE;
+
+  BOOL IsCSV = FileName.size() > 4 && FileName.compare(FileName.size() - 4, 4, ".csv") == 0;
+  std::string Text;
+
+  // label is quoted in both formats
+  for (CHAR Ch : Label)
+  {
+    if (Ch == '"' || (Ch == '\\' && !IsCSV))
+      Text += IsCSV ? '"' : '\\';
+    Text += Ch;
+  }
+
+  if (IsCSV)
+  {
+    fprintf(F, "name,value\nlabel,\"%s\"\nenabled,%d\n", Text.c_str(), IsEnabled() ? 1 : 0);
+    for (INT i = 0; i < COUNTER_COUNT; i++)
+      fprintf(F, "%s,%llu\n", StatsCounterNames[i], static_cast<unsigned long long>(Counters[i]));
+    for (INT i = 0; i < TIMER_COUNT; i++)
+      fprintf(F, "%s,%.6f\n", StatsTimerNames[i], Timers[i]);
+    for (INT i = 0; i < MaxDepth; i++)
+      fprintf(F, "depth_%d,%llu\n", i, static_cast<unsigned long long>(Depths[i]));
+  }
+  else
+  {
+    fprintf(F, "{\n  \"label\": \"%s\",\n  \"enabled\": %s,\n  \"counters\": {\n", Text.c_str(),
+      IsEnabled() ? "true" : "false");
+    for (INT i = 0; i < COUNTER_COUNT; i++)
+      fprintf(F, "    \"%s\": %llu%s\n", StatsCounterNames[i], static_cast<unsigned long long>(Counters[i]),
+        i + 1 < COUNTER_COUNT ? "," : "");
+    fprintf(F, "  },\n  \"timers\": {\n");
+    for (INT i = 0; i < TIMER_COUNT; i++)
+      fprintf(F, "    \"%s\": %.6f%s\n", StatsTimerNames[i], Timers[i], i + 1 < TIMER_COUNT ? "," : "");
+    fprintf(F, "  },\n  \"depths\": [");
+    for (INT i = 0; i < MaxDepth; i++)
+      fprintf(F, "%llu%s", static_cast<unsigned long long>(Depths[i]), i + 1 < MaxDepth ? ", " : "");
+    fprintf(F, "]\n}\n");
+  }
+
+  BOOL IsOk = !ferror(F);
+
+  fclose(F);
+  return IsOk;
+} /* End of 'Save' function */
+
+/* END OF 'stats.cpp' FILE */
@@ -0,0 +1,190 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : stats.h
+ * PURPOSE     : Ray tracing project.
+ *               Rendering statistics counters handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *               Counters are updated only when 'GORT_STATS' is
+ *               defined, otherwise 'GORT_STAT_*' macros are empty.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __stats_h_
+#define __stats_h_
+
+#include <chrono>
+#include <string>
+
+#include "../../def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Rendering statistics class.
+   * Every thread counts to own block, blocks are summed to one by
+   * 'Collect' at the end of frame (while rendering threads wait). */
+  class stats
+  {
+  public:
+    /* Event counters */
+    enum counter
+    {
+      CAMERA_RAYS,     // Traced camera rays
+      SECONDARY_RAYS,  // Traced reflected and refracted rays
+      MISSED_RAYS,     // Camera and secondary rays without hit
+      SHADOW_RAYS,     // Traced shadow rays
+      SHADOW_BLOCKED,  // Blocked shadow rays
+      SHADE_CALLS,     // Shaded hits
+      LIGHT_SAMPLES,   // Lights evaluated at shaded hits
+      NODE_VISITS,     // Hierarchy nodes visited by single rays
+      PACKET_VISITS,   // Hierarchy nodes visited by ray packets
+      SPHERE_TESTS,    // Sphere intersection tests
+      BOX_TESTS,       // Box intersection tests
+      TRIANGLE_TESTS,  // Triangle intersection tests
+      PLANE_TESTS,     // Plane intersection tests
+      MESH_TESTS,      // Mesh triangle intersection tests
+      INSTANCE_TESTS,  // Instance transforms of rays
+      TEXEL_QUADS,     // Bilinear texel quads read by texture sampling
+      TEXEL_HITS,      // Texel quads found in texel cache
+      COUNTER_COUNT
+    };
+
+    /* Accumulated timers */
+    enum timer
+    {
+      BUILD_TIME,      // Scene hierarchies build
+      TILE_TIME,       // Tiles rendering (all threads)
+      SHADOW_TIME,     // Shadow rays tracing (all threads)
+      TIMER_COUNT
+    };
+
+    static const INT MaxDepth = 16;  // Path depth histogram size (last bin keeps deeper rays)
+
+    UINT64 Counters[COUNTER_COUNT] {};  // Event counters
+    DBL Timers[TIMER_COUNT] {};         // Timers in seconds
+    UINT64 Depths[MaxDepth] {};         // Traced rays by path depth
+
+    /* Add other statistics function.
+     * ARGUMENTS:
+     *   - statistics to be added:
+     *      const stats &S;
+     * RETURNS:
+     *   (stats &) self reference.
+     */
+    stats & operator+=( const stats &S )
+    {
+      for (INT i = 0; i < COUNTER_COUNT; i++)
+        Counters[i] += S.Counters[i];
+      for (INT i = 0; i < TIMER_COUNT; i++)
+        Timers[i] += S.Timers[i];
+      for (INT i = 0; i < MaxDepth; i++)
+        Depths[i] += S.Depths[i];
+      return *this;
+    } /* End of 'operator+=' function */
+
+    /* Count traced path ray function.
+     * ARGUMENTS:
+     *   - path depth of the ray (0 for camera ray):
+     *      INT Depth;
+     * RETURNS: None.
+     */
+    VOID Ray( INT Depth )
+    {
+      Counters[Depth == 0 ? CAMERA_RAYS : SECONDARY_RAYS]++;
+      Depths[min(Depth, MaxDepth - 1)]++;
+    } /* End of 'Ray' function */
+
+    /* Obtain current thread statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (stats &) thread statistics block.
+     */
+    static stats & Local( VOID );
+
+    /* Sum statistics of all threads function.
+     * ARGUMENTS:
+     *   - clear thread blocks flag:
+     *      BOOL IsReset;
+     * RETURNS:
+     *   (stats) summed statistics.
+     */
+    static stats Collect( BOOL IsReset = TRUE );
+
+    /* Check if counters are compiled in function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if 'GORT_STATS' build.
+     */
+    static BOOL IsEnabled( VOID )
+    {
+#ifdef GORT_STATS
+      return TRUE;
+#else
+      return FALSE;
+#endif /* GORT_STATS */
+    } /* End of 'IsEnabled' function */
+
+    /* Save statistics by file extension function.
+     * ARGUMENTS:
+     *   - file name ('*.csv' for name,value lines, JSON otherwise):
+     *      const std::string &FileName;
+     *   - run label (scene and settings):
+     *      const std::string &Label;
+     * RETURNS:
+     *   (BOOL) TRUE if file saved.
+     */
+    BOOL Save( const std::string &FileName, const std::string &Label ) const;
+  }; /* End of 'stats' class */
+
+  /* Scope time to statistics timer class */
+  class stats_timer
+  {
+  private:
+    stats::timer Timer;                                           // Accumulated timer
+    std::chrono::high_resolution_clock::time_point Start;         // Scope start time
+
+  public:
+    /* Start timer constructor.
+     * ARGUMENTS:
+     *   - accumulated timer:
+     *      stats::timer NewTimer;
+     */
+    explicit stats_timer( stats::timer NewTimer ) : Timer(NewTimer), Start(std::chrono::high_resolution_clock::now())
+    {
+    } /* End of 'stats_timer' function */
+
+    /* Stop timer destructor */
+    ~stats_timer( VOID )
+    {
+      stats::Local().Timers[Timer] +=
+        std::chrono::duration<DBL>(std::chrono::high_resolution_clock::now() - Start).count();
+    } /* End of '~stats_timer' function */
+  }; /* End of 'stats_timer' class */
+} /* end of 'gort' namespace */
+
+#ifdef GORT_STATS
+/* Increase counter */
+#define GORT_STAT_INC(Counter) (gort::stats::Local().Counters[gort::stats::Counter]++)
+/* Add to counter */
+#define GORT_STAT_ADD(Counter, N) (gort::stats::Local().Counters[gort::stats::Counter] += (N))
+/* Count traced path ray of depth */
+#define GORT_STAT_RAY(Depth) (gort::stats::Local().Ray(Depth))
+/* Time rest of scope */
+#define GORT_STAT_TIMER(Timer) gort::stats_timer StatTimer##Timer(gort::stats::Timer)
+#else
+#define GORT_STAT_INC(Counter) ((VOID)0)
+#define GORT_STAT_ADD(Counter, N) ((VOID)0)
+#define GORT_STAT_RAY(Depth) ((VOID)0)
+#define GORT_STAT_TIMER(Timer) ((VOID)0)
+#endif /* GORT_STATS */
+
+#endif /* __stats_h_ */
+
+/* END OF 'stats.h' FILE */
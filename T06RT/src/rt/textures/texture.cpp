@@ -0,0 +1,365 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : texture.cpp
+ * PURPOSE     : Ray tracing project.
+ *               Mip mapped image texture implementation module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include <atomic>
+#include <cmath>
+#include <fstream>
+
+#include "texture.h"
+#include "../stats/stats.h"
+
+/* Texel cache entries count (power of 2) */
+#define TEXEL_CACHE_SIZE 64
+
+/* Decoded texel quad cache entry class.
+ * Neighbour rays of a tile mostly read the same bilinear quads, so
+ * the quad colors are kept decoded per thread. */
+class texel_quad
+{
+public:
+  UINT64 Id = 0;     // Texture number (0 - free entry)
+  INT Level = 0;     // Mip level
+  INT X = 0, Y = 0;  // Quad left top texel
+  FLT C[4][3] {};    // Quad colors (left top, right top, left bottom, right bottom)
+}; /* End of 'texel_quad' class */
+
+/* Texel colors scale */
+static const FLT TexelScale = 1.0f / 255;
+
+/* Decode texel color component function.
+ * ARGUMENTS:
+ *   - texel:
+ *      DWORD T;
+ *   - component number:
+ *      INT I;
+ * RETURNS:
+ *   (FLT) component value in [0, 1].
+ */
+static FLT TexelComponent( DWORD T, INT I )
+{
+  return ((T >> I * 8) & 0xFF) * TexelScale;
+} /* End of 'TexelComponent' function */
+
+/* Obtain next power of 2 function.
+ * ARGUMENTS:
+ *   - number:
+ *      INT N;
+ * RETURNS:
+ *   (INT) smallest power of 2 not less than N.
+ */
+static INT TexturePow2( INT N )
+{
+  INT P = 1;
+
+  while (P < N)
+    P <<= 1;
+  return P;
+} /* End of 'TexturePow2' function */
+
+/* Texture constructor.
+ * ARGUMENTS: None.
+ */
+gort::texture::texture( VOID )
+{
+  static std::atomic<UINT64> Textures {0};
+
+  Id = ++Textures;
+} /* End of 'texture' function */
+
+/* Create texture from image function.
+ * ARGUMENTS:
+ *   - image size:
+ *      INT W, H;
+ *   - image colors by rows from the top one:
+ *      const DWORD *Pixels;
+ * RETURNS: None.
+ */
+VOID gort::texture::Create( INT W, INT H, const DWORD *Pixels )
+{
+  Levels.clear();
+  if (W <= 0 || H <= 0)
+    return;
+
+  INT PW = TexturePow2(W), PH = TexturePow2(H);
+  std::vector<FLT> Img(PW * PH * 3), Next;
+
+  // resample image to power of 2 sides (bilinear, repeated)
+  for (INT y = 0; y < PH; y++)
+    for (INT x = 0; x < PW; x++)
+    {
+      DBL
+        sx = (x + 0.5) * W / PW - 0.5,
+        sy = (y + 0.5) * H / PH - 0.5;
+      INT
+        x0 = static_cast<INT>(floor(sx)),
+        y0 = static_cast<INT>(floor(sy));
+      FLT
+        fx = static_cast<FLT>(sx - x0),
+        fy = static_cast<FLT>(sy - y0);
+      INT
+        x1 = (x0 + 1 + W) % W, y1 = (y0 + 1 + H) % H;
+
+      x0 = (x0 + W) % W;
+      y0 = (y0 + H) % H;
+      for (INT i = 0; i < 3; i++)
+        Img[(y * PW + x) * 3 + i] =
+          (TexelComponent(Pixels[y0 * W + x0], i) * (1 - fx) + TexelComponent(Pixels[y0 * W + x1], i) * fx) * (1 - fy) +
+          (TexelComponent(Pixels[y1 * W + x0], i) * (1 - fx) + TexelComponent(Pixels[y1 * W + x1], i) * fx) * fy;
+    }
+
+  // store levels by tiles, every next level is 2 x 2 box filtered previous one
+  for (;;)
+  {
+    level L;
+
+    L.W = PW;
+    L.H = PH;
+    L.TilesX = (PW + 7) >> 3;
+    L.Texels.resize(L.TilesX * ((PH + 7) >> 3) * 64);
+    for (INT y = 0; y < PH; y++)
+      for (INT x = 0; x < PW; x++)
+      {
+        const FLT *C = &Img[(y * PW + x) * 3];
+
+        L.Texels[L.Index(x, y)] = mth::toRGB(vec3(C[0], C[1], C[2]));
+      }
+    Levels.push_back(std::move(L));
+    if (PW == 1 && PH == 1)
+      break;
+
+    INT
+      NW = PW > 1 ? PW / 2 : 1,
+      NH = PH > 1 ? PH / 2 : 1,
+      SX = PW > 1 ? 1 : 0,
+      SY = PH > 1 ? 1 : 0;
+
+    Next.assign(NW * NH * 3, 0);
+    for (INT y = 0; y < NH; y++)
+      for (INT x = 0; x < NW; x++)
+      {
+        const FLT
+          *C00 = &Img[((y << SY) * PW + (x << SX)) * 3],
+          *C01 = C00 + SX * 3,
+          *C10 = C00 + SY * PW * 3,
+          *C11 = C10 + SX * 3;
+
+        for (INT i = 0; i < 3; i++)
+          Next[(y * NW + x) * 3 + i] = (C00[i] + C01[i] + C10[i] + C11[i]) * 0.25f;
+      }
+    Img.swap(Next);
+    PW = NW;
+    PH = NH;
+  }
+} /* End of 'Create' function */
+
+/* Load texture from image file function.
+ * ARGUMENTS:
+ *   - image file name (uncompressed .tga or binary .ppm):
+ *      const std::string &FileName;
+ * RETURNS:
+ *   (BOOL) TRUE if image loaded.
+ */
+BOOL gort::texture::Load( const std::string &FileName )
+{
+  std::ifstream f(FileName, std::ifstream::binary);
+  BYTE Head[18];
+  INT W, H;
+  std::vector<DWORD> Pixels;
+
+  if (!f.read((CHAR *)Head, 2))
+    return FALSE;
+
+  if (Head[0] == 'P' && Head[1] == '6')
+  {
+    // binary portable pixmap
+    INT Max;
+
+    if (!(f >> W >> H >> Max) || W <= 0 || H <= 0 || Max <= 0 || Max > 255)
+      return FALSE;
+    f.get();
+
+    std::vector<BYTE> Row(W * 3);
+
+    Pixels.resize(W * H);
+    for (INT y = 0; y < H; y++)
+    {
+      if (!f.read((CHAR *)Row.data(), Row.size()))
+        return FALSE;
+      for (INT x = 0; x < W; x++)
+        Pixels[y * W + x] =
+          (Row[x * 3 + 2] * 255 / Max) | (Row[x * 3 + 1] * 255 / Max) << 8 | (Row[x * 3 + 0] * 255 / Max) << 16;
+    }
+  }
+  else
+  {
+    // truevision targa (true color or grey, plain or RLE)
+    if (!f.read((CHAR *)Head + 2, 16))
+      return FALSE;
+
+    INT
+      Type = Head[2] & ~8,
+      Bpp = Head[16] / 8,
+      MapSize = Head[1] ? (Head[5] | Head[6] << 8) * ((Head[7] + 7) / 8) : 0;
+
+    W = Head[12] | Head[13] << 8;
+    H = Head[14] | Head[15] << 8;
+    if (W <= 0 || H <= 0 || (Type == 2 && Bpp != 3 && Bpp != 4) || (Type == 3 && Bpp != 1) || (Type != 2 && Type != 3))
+      return FALSE;
+    f.ignore(Head[0] + MapSize);
+
+    BOOL IsRLE = (Head[2] & 8) != 0, IsTop = (Head[17] & 0x20) != 0;
+    INT Count = 0, Run = 0;
+    BOOL IsRepeat = FALSE;
+    BYTE P[4] {};
+
+    Pixels.resize(W * H);
+    for (INT i = 0; i < W * H; i++)
+    {
+      if (!IsRLE || Run == 0 || !IsRepeat)
+      {
+        if (IsRLE && Run == 0)
+        {
+          INT C = f.get();
+
+          if (C < 0)
+            return FALSE;
+          IsRepeat = (C & 0x80) != 0;
+          Run = (C & 0x7F) + 1;
+          Count = 0;
+        }
+        if (!IsRepeat || Count == 0)
+          if (!f.read((CHAR *)P, Bpp))
+            return FALSE;
+      }
+      Count++;
+      Run--;
+
+      INT y = IsTop ? i / W : H - 1 - i / W;
+
+      Pixels[y * W + i % W] = Bpp == 1 ? P[0] * 0x010101u : P[0] | P[1] << 8 | P[2] << 16;
+    }
+  }
+  Create(W, H, Pixels.data());
+  return TRUE;
+} /* End of 'Load' function */
+
+/* Create checker texture function.
+ * ARGUMENTS:
+ *   - image side in texels:
+ *      INT Size;
+ *   - cells in row:
+ *      INT Cells;
+ *   - cells colors:
+ *      const vec3 &A, &B;
+ * RETURNS: None.
+ */
+VOID gort::texture::Checker( INT Size, INT Cells, const vec3 &A, const vec3 &B )
+{
+  std::vector<DWORD> Pixels(Size * Size);
+  DWORD CA = mth::toRGB(A), CB = mth::toRGB(B);
+
+  Cells = max(Cells, 1);
+  for (INT y = 0; y < Size; y++)
+    for (INT x = 0; x < Size; x++)
+      Pixels[y * Size + x] = ((x * Cells / Size + y * Cells / Size) & 1) ? CB : CA;
+  Create(Size, Size, Pixels.data());
+} /* End of 'Checker' function */
+
+/* Bilinear sample of mip level function.
+ * ARGUMENTS:
+ *   - mip level number:
+ *      INT Level;
+ *   - texture coordinates:
+ *      REAL U, V;
+ * RETURNS:
+ *   (vec3) filtered color.
+ */
+gort::vec3 gort::texture::Bilinear( INT Level, REAL U, REAL V ) const
+{
+  thread_local texel_quad Cache[TEXEL_CACHE_SIZE];
+  const level &L = Levels[Level];
+  REAL
+    x = U * L.W - 0.5,
+    y = V * L.H - 0.5,
+    fx0 = floor(x),
+    fy0 = floor(y);
+  INT
+    x0 = static_cast<INT>(fx0 - floor(fx0 / L.W) * L.W) & (L.W - 1),
+    y0 = static_cast<INT>(fy0 - floor(fy0 / L.H) * L.H) & (L.H - 1);
+  FLT
+    fx = static_cast<FLT>(x - fx0),
+    fy = static_cast<FLT>(y - fy0);
+  texel_quad &Q =
+    Cache[(static_cast<DWORD>(x0) * 0x9E3779B1u ^ static_cast<DWORD>(y0) * 0x85EBCA77u ^
+           static_cast<DWORD>(Id * 31 + Level)) & (TEXEL_CACHE_SIZE - 1)];
+
+  GORT_STAT_INC(TEXEL_QUADS);
+  if (Q.Id == Id && Q.Level == Level && Q.X == x0 && Q.Y == y0)
+    GORT_STAT_INC(TEXEL_HITS);
+  else
+  {
+    DWORD T[4] = {L.Get(x0, y0), L.Get(x0 + 1, y0), L.Get(x0, y0 + 1), L.Get(x0 + 1, y0 + 1)};
+
+    Q.Id = Id;
+    Q.Level = Level;
+    Q.X = x0;
+    Q.Y = y0;
+    for (INT k = 0; k < 4; k++)
+      for (INT i = 0; i < 3; i++)
+        Q.C[k][i] = TexelComponent(T[k], i);
+  }
+
+  vec3 C;
+
+  for (INT i = 0; i < 3; i++)
+    C[i] = (Q.C[0][i] * (1 - fx) + Q.C[1][i] * fx) * (1 - fy) + (Q.C[2][i] * (1 - fx) + Q.C[3][i] * fx) * fy;
+  return C;
+} /* End of 'Bilinear' function */
+
+/* Sample texture function.
+ * Trilinear filtering between two mip levels, texture repeats.
+ * ARGUMENTS:
+ *   - texture coordinates (0..1 covers image once):
+ *      REAL U, V;
+ *   - texture coordinates footprint (texture sizes per pixel):
+ *      REAL Footprint;
+ * RETURNS:
+ *   (vec3) filtered color.
+ */
+gort::vec3 gort::texture::Sample( REAL U, REAL V, REAL Footprint ) const
+{
+  if (Levels.empty())
+    return vec3(1);
+
+  INT Last = static_cast<INT>(Levels.size()) - 1;
+  REAL Texels = Footprint * max(Levels[0].W, Levels[0].H);
+
+  // magnification or unknown footprint
+  if (!(Texels > 1))
+    return Bilinear(0, U, V);
+
+  REAL Lod = log2(Texels);
+
+  if (Lod >= Last)
+    return Bilinear(Last, U, V);
+
+  INT L = static_cast<INT>(Lod);
+  REAL f = Lod - L;
+
+  return Bilinear(L, U, V) * (1 - f) + Bilinear(L + 1, U, V) * f;
+} /* End of 'Sample' function */
+
+/* END OF 'texture.cpp' FILE */
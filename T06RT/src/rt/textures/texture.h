@@ -0,0 +1,169 @@
+/*************************************************************
+ * Copyright (C) 2021
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : texture.h
+ * PURPOSE     : Ray tracing project.
+ *               Mip mapped image texture handle module.
+ * PROGRAMMER  : Dan Gorlyakov.
+ * LAST UPDATE : 17.10.2026.
+ * NOTE        : Module namespace 'gort'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __texture_h_
+#define __texture_h_
+
+#include <string>
+#include <vector>
+
+#include "../../def.h"
+
+/* Space gort namespace */
+namespace gort
+{
+  /* Mip mapped texture class.
+   * Image is resampled to power of 2 sides and all mip levels are built
+   * on load. Every level is stored by 8 x 8 texel tiles (256 bytes),
+   * texels of tile are in Morton order, so a bilinear footprint and
+   * its neighbours mostly share one or two cache lines. Texels keep
+   * colors as 'toRGB' does (component 0 in the low byte). */
+  class texture
+  {
+  private:
+    /* Mip level class */
+    class level
+    {
+    public:
+      INT W = 0, H = 0;            // Level size in texels (powers of 2)
+      INT TilesX = 0;              // Tiles in row
+      std::vector<DWORD> Texels;   // Texels by tiles
+
+      /* Obtain texel index in tiled storage function.
+       * ARGUMENTS:
+       *   - texel coordinates (in level):
+       *      INT X, Y;
+       * RETURNS:
+       *   (INT) texel index.
+       */
+      INT Index( INT X, INT Y ) const
+      {
+        static const BYTE Spread[8] = {0, 1, 4, 5, 16, 17, 20, 21};
+
+        return ((Y >> 3) * TilesX + (X >> 3)) << 6 | Spread[X & 7] | Spread[Y & 7] << 1;
+      } /* End of 'Index' function */
+
+      /* Obtain texel function.
+       * ARGUMENTS:
+       *   - texel coordinates (wrapped):
+       *      INT X, Y;
+       * RETURNS:
+       *   (DWORD) texel color.
+       */
+      DWORD Get( INT X, INT Y ) const
+      {
+        return Texels[Index(X & (W - 1), Y & (H - 1))];
+      } /* End of 'Get' function */
+    }; /* End of 'level' class */
+
+    std::vector<level> Levels;  // Mip levels (0 - full size)
+    UINT64 Id;                  // Unique texture number (texel cache key)
+
+    /* Bilinear sample of mip level function.
+     * ARGUMENTS:
+     *   - mip level number:
+     *      INT Level;
+     *   - texture coordinates:
+     *      REAL U, V;
+     * RETURNS:
+     *   (vec3) filtered color.
+     */
+    vec3 Bilinear( INT Level, REAL U, REAL V ) const;
+
+  public:
+    /* Texture constructor.
+     * ARGUMENTS: None.
+     */
+    texture( VOID );
+
+    /* Create texture from image function.
+     * ARGUMENTS:
+     *   - image size:
+     *      INT W, H;
+     *   - image colors by rows from the top one:
+     *      const DWORD *Pixels;
+     * RETURNS: None.
+     */
+    VOID Create( INT W, INT H, const DWORD *Pixels );
+
+    /* Load texture from image file function.
+     * ARGUMENTS:
+     *   - image file name (uncompressed .tga or binary .ppm):
+     *      const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if image loaded.
+     */
+    BOOL Load( const std::string &FileName );
+
+    /* Create checker texture function.
+     * ARGUMENTS:
+     *   - image side in texels:
+     *      INT Size;
+     *   - cells in row:
+     *      INT Cells;
+     *   - cells colors:
+     *      const vec3 &A, &B;
+     * RETURNS: None.
+     */
+    VOID Checker( INT Size, INT Cells, const vec3 &A, const vec3 &B );
+
+    /* Sample texture function.
+     * Trilinear filtering between two mip levels, texture repeats.
+     * ARGUMENTS:
+     *   - texture coordinates (0..1 covers image once):
+     *      REAL U, V;
+     *   - texture coordinates footprint (texture sizes per pixel):
+     *      REAL Footprint;
+     * RETURNS:
+     *   (vec3) filtered color.
+     */
+    vec3 Sample( REAL U, REAL V, REAL Footprint ) const;
+
+    /* Obtain full size width function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) width in texels.
+     */
+    INT GetW( VOID ) const
+    {
+      return Levels.empty() ? 0 : Levels[0].W;
+    } /* End of 'GetW' function */
+
+    /* Obtain full size height function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) height in texels.
+     */
+    INT GetH( VOID ) const
+    {
+      return Levels.empty() ? 0 : Levels[0].H;
+    } /* End of 'GetH' function */
+
+    /* Obtain mip levels count function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) levels count.
+     */
+    INT GetLevelCount( VOID ) const
+    {
+      return static_cast<INT>(Levels.size());
+    } /* End of 'GetLevelCount' function */
+  }; /* End of 'texture' class */
+} /* end of 'gort' namespace */
+
+#endif /* __texture_h_ */
+
+/* END OF 'texture.h' FILE */